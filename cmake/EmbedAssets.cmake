@@ -0,0 +1,32 @@
+# Génère un fichier C++ contenant les ressources de l'interface, exposées par
+# AssetStore::embedded(). Appelé au build : cmake -DOUTPUT=… -DASSETS=a|b -P …
+string(REPLACE "|" ";" ASSETS "${ASSETS}")
+
+string(REPEAT "0x..," 16 line)
+set(arrays "")
+set(table "")
+set(index 0)
+foreach(asset IN LISTS ASSETS)
+  get_filename_component(name "${asset}" NAME)
+  file(READ "${asset}" hex HEX)
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+  # 16 octets par ligne (pas de quantificateur {n} dans les regex CMake)
+  string(REGEX REPLACE "(${line})" "\\1\n    " bytes "${bytes}")
+  string(APPEND arrays
+         "const unsigned char ASSET_${index}[] = {\n    ${bytes}};\n")
+  string(APPEND table
+         "        {\"${name}\", ASSET_${index}, sizeof(ASSET_${index})},\n")
+  math(EXPR index "${index} + 1")
+endforeach()
+
+file(
+  WRITE "${OUTPUT}.tmp"
+  "// Généré par cmake/EmbedAssets.cmake, ne pas modifier\n"
+  "#include \"Assets.hpp\"\n\n"
+  "namespace {\n${arrays}} // namespace\n\n"
+  "std::span<const EmbeddedAsset> AssetStore::embedded() {\n"
+  "    static constexpr EmbeddedAsset TABLE[] = {\n${table}    };\n"
+  "    return TABLE;\n}\n")
+# Pas de recompilation si le contenu n'a pas changé
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
@@ -0,0 +1,26 @@
+#ifndef CODE_UI_INCLUDE_ALLOCCOUNTER_HPP_
+#define CODE_UI_INCLUDE_ALLOCCOUNTER_HPP_
+
+#include <cstdint>
+
+namespace AllocCounter {
+
+/// Mode audit (`-DALLOC_AUDIT=ON`) : `malloc` et dérivés sont comptés aussi,
+/// et le profileur journalise chaque image qui alloue
+#ifdef UI_ALLOC_AUDIT
+inline constexpr bool AUDIT{true};
+#else
+inline constexpr bool AUDIT{false};
+#endif
+
+/**
+ * @brief Nombre d'allocations du thread appelant depuis son démarrage :
+ * appels à `operator new`, et en mode audit à `malloc`, `calloc`, `realloc`
+ * et `aligned_alloc` (fonctions remplacées dans `AllocCounter.cpp`)
+ * @return Compteur monotone, à soustraire entre deux relevés
+ */
+[[nodiscard]] uint64_t threadCount() noexcept;
+
+} // namespace AllocCounter
+
+#endif // CODE_UI_INCLUDE_ALLOCCOUNTER_HPP_
@@ -1,7 +1,21 @@
 #ifndef CODE_UI_INCLUDE_APPCONTROLLER_HPP_
 #define CODE_UI_INCLUDE_APPCONTROLLER_HPP_
 
+#include "Assets.hpp"
 #include "Communication.hpp"
+#include "FallingNotes.hpp"
+#include "FrameArena.hpp"
+#include "FramePipeline.hpp"
+#include "InputProvider.hpp"
+#include "KeyboardModel.hpp"
+#include "LayerCache.hpp"
+#include "Layout.hpp"
+#include "PlayViewModel.hpp"
+#include "Profiler.hpp"
+#include "ResultParticles.hpp"
+#include "ScriptedInput.hpp"
+#include "Session.hpp"
+#include "TextCache.hpp"
 #include "Types.hpp"
 #include "raylib.h"
 #include <cstdint>
@@ -13,10 +27,19 @@ class AppController {
   private:
     // Process & System variables
     pid_t enginePid_{-1};
+    std::string enginePath_;
     bool verbose_{false};
     bool fullscreen_{false};
     int32_t timeoutMs_{-1};
     float timeoutTimer_{0.0f};
+    ThreadPolicy renderPolicy_; ///< Affinité du thread de rendu (principal)
+    ThreadPolicy drawPolicy_;   ///< Affinité du thread d'enregistrement
+    bool drawThread_{true};     ///< Images enregistrées sur un thread dédié
+    std::string fontPath_;      ///< Police TTF des atlas, vide par défaut
+
+    // Entrées et horloge de la boucle : fenêtre, ou scénario rejoué
+    RaylibInput windowInput_;
+    InputProvider* input_{&windowInput_};
 
     // Connection & Communication variables
     Communication comm_;
@@ -24,13 +47,14 @@ class AppController {
     float connRetryTimer_{0.0f};
 
     // User session state
-    std::vector<UserProfile> profiles_;
+    std::vector<UserProfile> profiles_{{"Utilisateur", 0, SKYBLUE}};
     int32_t currentUserIdx_{0};
     bool isNamingProfile_{false};
     std::string inputName_;
 
     // Game state
     AppState appState_{AppState::PROFILE_SELECT};
+    SessionDriver session_; ///< Déroulé de la partie (coroutine)
     bool isPaused_{false};
     ScaleChoice selectedScale_{ScaleChoice::SCALE_C};
     ModeChoice selectedMode_{ModeChoice::MODE_MAJ};
@@ -39,6 +63,7 @@ class AppController {
     int32_t scoreActuel_{0};
     NotationMode selectedNotation_{NotationMode::SYLLABIC};
     bool showKeyboard_{true};
+    bool showFallingNotes_{false}; ///< Notes qui tombent vers le clavier
 
     // Challenges and stats
     Challenge currentChallenge_;
@@ -52,13 +77,23 @@ class AppController {
     std::string errorMsg_;
     float errorTimer_{0.0f};
 
-    // Piano key presses (virtual)
-    bool blanchesAppuyees_[14]{};
-    bool noiresAppuyees_[10]{};
-
-    // Index mappings for keyboard black keys
-    static constexpr int32_t kBlackKeyIndices[10] = {0, 1, 3,  4,  5,
-                                                     7, 8, 10, 11, 12};
+    // Piano virtuel (géométrie, appuis et marquages)
+    KeyboardModel keyboard_;
+    PlayViewModel playView_;  ///< Écran de jeu préparé
+    FallingNotes falling_;    ///< Notes des défis en chute, en option
+    ResultParticles effects_; ///< Gerbes et points des résultats
+    LayerCache layers_;       ///< Couches statiques rendues en texture
+    TextCache text_;          ///< Textes préparés et atlas de police
+    Layout layout_;           ///< Rectangles de l'écran courant, clics
+    AssetStore assets_;       ///< Images embarquées, décodées au démarrage
+    FrameProfiler profiler_;  ///< Durées par étape, HUD (F3 ou --profile)
+    FramePipeline frames_;    ///< Listes de dessin en double tampon
+    FrameArena arena_;        ///< Temporaires de l'image en enregistrement
+
+    // Latence clavier → image : premier appui pas encore enregistré, puis
+    // appui de l'image en attente de présentation (-1 : aucun)
+    double keyPressTime_{-1.0};
+    double keyShownTime_{-1.0};
 
   public:
     AppController();
@@ -81,6 +116,15 @@ class AppController {
      */
     void run();
 
+    /**
+     * @brief Rejoue un scénario sans fenêtre ni moteur, aussi vite que le
+     * permet la logique : entrées et horloge scriptées, messages du moteur
+     * injectés à leur date, envois enregistrés dans le scénario ; les images
+     * sont enregistrées mais jamais soumises
+     * @param script Scénario, débranché à la fin du rejeu
+     */
+    void replay(ScriptedInput& script);
+
     /**
      * @brief Nettoie proprement les ressources (arrête le moteur, déconnecte le
      * socket)
@@ -88,11 +132,51 @@ class AppController {
     void cleanup();
 
   private:
-    void processIncomingMessages();
-    void updateLogic(float dt, Vector2 mouse, bool clicked, float screenW,
-                     float screenH);
-    void handleVirtualKeyboardInput(float pianoY, Vector2 mouse, float screenW,
-                                    float screenH);
+    /**
+     * @brief Boucle principale : entrées, messages, logique, puis rendu ou
+     * attente d'un événement, jusqu'à la fermeture ou au délai de sécurité
+     * @param render `false` pour ne rien soumettre : les images sont
+     * enregistrées sans fenêtre (rejeu)
+     */
+    void loop(bool render);
+    /**
+     * @brief Traite les messages reçus du moteur
+     * @return `true` si au moins un message a été traité
+     */
+    bool processIncomingMessages();
+    /**
+     * @brief Délai d'attente d'événement quand rien n'est à redessiner,
+     * borné par la prochaine échéance (session, reconnexion, fondu, arrêt)
+     * @return Secondes à attendre au plus
+     */
+    [[nodiscard]] double idleTimeout() const;
+    /**
+     * @brief Recalcule la mise en page si l'écran a changé, puis le survol
+     */
+    void refreshLayout(Vector2 mouse, float screenW, float screenH);
+    void updateLogic(const InputFrame& in);
+    /**
+     * @brief Envoie au moteur un accord joué au clavier virtuel (`play`),
+     * ignoré hors défi en attente de réponse
+     * @param chord Appuis horodatés, dans l'ordre
+     * @param now Instant courant, même horloge que les appuis
+     */
+    void sendPlay(const Chord& chord, double now);
+    void recoverStalledEngine();
+    /**
+     * @brief Déroulé d'une partie : config → ack, puis ready → défi →
+     * résultat → affichage, jusqu'à `over`
+     * @param gtId Identifiant du type de jeu
+     */
+    SessionTask playSession(std::string gtId);
+    void applyChallenge(const Message& msg);
+    void applyResult(const Message& msg);
+    /**
+     * @brief Gerbes depuis les touches jouées, vertes si justes, rouges si
+     * fausses ; depuis la zone de défi si la touche n'est pas à l'écran
+     */
+    void burstResultKeys();
+    void finishGame(const Message& msg);
     void startGame(const std::string& gtId);
     void quitGame();
     [[nodiscard]] int32_t getSelectedGameKeys() const;
@@ -102,6 +186,8 @@ class AppController {
 
     // Give UI class full read/write access to state details
     friend class UI;
+    // Benchmark de rendu hors écran : états synthétiques (test/UIBench.cpp)
+    friend class UIBench;
 };
 
 #endif // CODE_UI_INCLUDE_APPCONTROLLER_HPP_
@@ -0,0 +1,75 @@
+#ifndef CODE_UI_INCLUDE_ASSETS_HPP_
+#define CODE_UI_INCLUDE_ASSETS_HPP_
+
+#include "raylib.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <span>
+#include <string_view>
+
+/// Fichier de ressource compilé dans l'exécutable (généré par CMake)
+struct EmbeddedAsset {
+    std::string_view name; ///< Nom du fichier source (ex : "GClef.png")
+    const unsigned char* data;
+    size_t size;
+};
+
+/// Images de l'interface
+enum class ImageAsset : uint8_t { G_CLEF, COUNT };
+
+/**
+ * @brief Ressources de l'interface : décodées en arrière-plan dès le
+ * démarrage, puis envoyées au GPU une fois la fenêtre créée, avant la première
+ * image
+ */
+class AssetStore {
+  private:
+    static constexpr size_t COUNT{static_cast<size_t>(ImageAsset::COUNT)};
+
+    std::array<std::future<Image>, COUNT> pending_;
+    std::array<Texture2D, COUNT> textures_{};
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    /**
+     * @brief Ressources compilées dans l'exécutable
+     * @return Table générée à la compilation
+     */
+    static std::span<const EmbeddedAsset> embedded();
+
+    /**
+     * @brief Cherche une ressource compilée par nom de fichier
+     * @param name Nom du fichier source
+     * @return Ressource, `nullptr` si absente
+     */
+    static const EmbeddedAsset* find(std::string_view name);
+
+    /**
+     * @brief Lance le décodage des images en arrière-plan (sans fenêtre)
+     */
+    void preload();
+
+    /**
+     * @brief Attend le décodage et envoie les textures au GPU ; à appeler
+     * après `InitWindow`
+     */
+    void upload();
+
+    /**
+     * @brief Texture d'une image
+     * @param asset Image
+     * @return Texture, d'identifiant 0 si indisponible
+     */
+    [[nodiscard]] Texture2D texture(ImageAsset asset) const {
+        return this->textures_[static_cast<size_t>(asset)];
+    }
+
+    /**
+     * @brief Libère les textures ; à appeler avant `CloseWindow`
+     */
+    void release();
+};
+
+#endif // CODE_UI_INCLUDE_ASSETS_HPP_
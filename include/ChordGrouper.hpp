@@ -0,0 +1,79 @@
+#ifndef CODE_UI_INCLUDE_CHORDGROUPER_HPP_
+#define CODE_UI_INCLUDE_CHORDGROUPER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/// Appui sur une touche, horodaté
+struct NotePress {
+    int32_t midi{-1}; ///< Numéro MIDI de la touche
+    double time{0.0}; ///< Instant de l'appui, horloge monotone (secondes)
+
+    bool operator==(const NotePress&) const = default;
+};
+
+/// Appuis quasi simultanés, joués comme un seul accord
+struct Chord {
+    std::vector<NotePress> notes; ///< Dans l'ordre des appuis
+
+    /**
+     * @brief Instant du premier appui
+     * @return Horodatage, 0 si l'accord est vide
+     */
+    [[nodiscard]] double start() const {
+        return this->notes.empty() ? 0.0 : this->notes.front().time;
+    }
+};
+
+/**
+ * @brief Regroupe en accords les appuis arrivés dans une courte fenêtre après
+ * le premier, en conservant l'instant de chaque appui
+ */
+class ChordGrouper {
+  public:
+    static constexpr double WINDOW{0.05}; ///< Fenêtre d'un accord (secondes)
+
+  private:
+    std::vector<NotePress> open_; ///< Accord en cours de saisie
+    std::deque<Chord> ready_;     ///< Accords clos, non encore lus
+
+  public:
+    /**
+     * @brief Ajoute un appui, à l'accord en cours s'il est dans sa fenêtre
+     * @param midi Numéro MIDI de la touche
+     * @param time Instant de l'appui
+     */
+    void press(int32_t midi, double time);
+
+    /**
+     * @brief Clôt l'accord en cours si sa fenêtre est écoulée
+     * @param now Instant courant
+     */
+    void update(double now);
+
+    /**
+     * @brief Délai avant la clôture de l'accord en cours
+     * @param now Instant courant
+     * @return Secondes restantes, 0 sans accord en cours
+     */
+    [[nodiscard]] double timeLeft(double now) const {
+        if (this->open_.empty()) return 0.0;
+        return std::max(this->open_.front().time + WINDOW - now, 0.0);
+    }
+
+    /**
+     * @brief Retire le plus ancien accord clos
+     * @param chord Accord lu
+     * @return `false` si aucun accord n'est clos
+     */
+    bool pop(Chord& chord);
+
+    /**
+     * @brief Abandonne l'accord en cours et les accords non lus
+     */
+    void clear();
+};
+
+#endif // CODE_UI_INCLUDE_CHORDGROUPER_HPP_
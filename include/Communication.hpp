@@ -1,9 +1,14 @@
 #ifndef CODE_UI_INCLUDE_COMMUNICATION_HPP_
 #define CODE_UI_INCLUDE_COMMUNICATION_HPP_
 
+#include "KeyStates.hpp"
 #include "Message.hpp"
+#include "ThreadTuning.hpp"
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <queue>
@@ -25,6 +30,65 @@
  */
 [[nodiscard]] Message deserialize(std::string_view data);
 
+/**
+ * @brief Histogramme glissant des temps d'aller-retour (RTT) du lien moteur
+ *
+ * Conserve les derniers échantillons dans un tampon circulaire et maintient
+ * des compteurs par tranche logarithmique (puissances de 2 en µs), dont sont
+ * déduits les percentiles.
+ */
+class RttHistogram {
+  public:
+    static constexpr size_t WINDOW{256}; ///< Échantillons conservés
+    static constexpr size_t BUCKETS{24}; ///< Tranches [2^b, 2^(b+1)[ µs
+
+  private:
+    std::array<uint32_t, WINDOW> samples_{}; ///< Derniers RTT (µs)
+    std::array<uint32_t, BUCKETS> buckets_{}; ///< Effectifs par tranche
+    size_t next_{0};                          ///< Prochaine case à écrire
+    size_t count_{0};                         ///< Échantillons présents
+
+  private:
+    /**
+     * @brief Calcule la tranche d'un RTT
+     * @param us RTT en microsecondes
+     * @return Index de tranche, borné à `BUCKETS - 1`
+     */
+    [[nodiscard]] static size_t bucketOf(uint32_t us) noexcept;
+
+  public:
+    /**
+     * @brief Ajoute un échantillon, en évinçant le plus ancien si plein
+     * @param us RTT en microsecondes
+     */
+    void record(uint32_t us) noexcept;
+
+    /**
+     * @brief Estime un percentile (borne haute de la tranche atteinte)
+     * @param p Percentile voulu, entre 0 et 1
+     * @return RTT estimé en microsecondes, 0 si aucun échantillon
+     */
+    [[nodiscard]] uint32_t percentile(double p) const noexcept;
+
+    [[nodiscard]] size_t count() const noexcept { return this->count_; }
+
+    [[nodiscard]] const std::array<uint32_t, BUCKETS>&
+    buckets() const noexcept {
+        return this->buckets_;
+    }
+};
+
+/// Instantané de l'état du lien moteur (battement de cœur `ping`/`pong`)
+struct LinkStats {
+    uint64_t pings{0};   ///< `ping` envoyés
+    uint64_t pongs{0};   ///< `pong` reçus
+    uint32_t lastUs{0};  ///< Dernier RTT (µs)
+    uint32_t p50Us{0};   ///< Médiane glissante (µs)
+    uint32_t p99Us{0};   ///< 99e percentile glissant (µs)
+    bool stalled{false}; ///< Moteur considéré bloqué
+    std::array<uint32_t, RttHistogram::BUCKETS> buckets{}; ///< Histogramme
+};
+
 /**
  * @brief Gère la communication client avec le moteur de jeu via Unix Domain
  * Socket
@@ -39,12 +103,74 @@ class Communication {
     std::atomic<bool> running_{
         false};                  ///< Indique si le thread d'écoute doit tourner
     std::thread listenerThread_; ///< Thread qui écoute les messages entrants
+    ThreadPolicy ioPolicy_;      ///< Ordonnancement du thread d'écoute
+    std::function<void()> wakeHandler_; ///< Appelé par le thread d'écoute
+    std::function<void(const Message&)> loopback_; ///< Lien simulé (rejeu)
+    bool loopbackUp_{false}; ///< Lien simulé « connecté »
 
     std::queue<Message>
         messageQueue_; ///< File d'attente thread-safe pour les messages reçus
     std::mutex queueMutex_; ///< Mutex pour protéger l'accès à la file
+    std::mutex writeMutex_; ///< Sérialise les écritures (UI et battement)
+    KeyStates keys_;        ///< `noteon`/`noteoff` depuis le dernier relevé
+    std::mutex keysMutex_;  ///< Protège `keys_`
+
+    // Battement de cœur, géré par le thread d'écoute
+    std::chrono::milliseconds heartbeatInterval_{0}; ///< 0 : désactivé
+    std::chrono::milliseconds stallDeadline_{3000}; ///< Délai avant blocage
+    std::atomic<bool> stalled_{false}; ///< Moteur muet au-delà du délai
+    uint64_t pingSeq_{0};              ///< Numéro du dernier `ping`
+    std::chrono::steady_clock::time_point pingSentAt_; ///< Envoi du `ping`
+    bool pingPending_{false}; ///< Dernier `ping` sans `pong` reçu
+    LinkStats stats_;                     ///< Compteurs du lien
+    RttHistogram rtt_;                    ///< Histogramme des RTT
+    mutable std::mutex statsMutex_;       ///< Protège `stats_` et `rtt_`
 
   private:
+    /**
+     * @brief Écrit des données brutes sur le socket
+     * @param data Données sérialisées
+     * @return `true` si l'écriture a réussi
+     */
+    [[nodiscard]] bool writeRaw(const std::string& data);
+
+    /**
+     * @brief Envoie un `ping` si l'intervalle est écoulé et détecte un moteur
+     * bloqué (appelé par le thread d'écoute)
+     * @param now Instant courant
+     */
+    void heartbeat(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Traite un `pong` : mesure du RTT et levée du blocage
+     * @param msg Message `pong` reçu
+     * @param now Instant de réception
+     */
+    void handlePong(const Message& msg,
+                    std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Applique un `noteon` ou un `noteoff` aux touches, sans passer
+     * par la file
+     * @param msg Message reçu
+     * @return `true` si le message était un événement de touche
+     */
+    bool routeKey(const Message& msg);
+
+    /**
+     * @brief Relâche les touches du piano réel, à la coupure ou au
+     * rétablissement du lien
+     */
+    void releaseKeys();
+
+    /**
+     * @brief Prévient l'interface qu'il y a du nouveau (message, blocage ou
+     * fermeture), depuis le thread d'écoute
+     */
+    void wake() const {
+        if (this->wakeHandler_) this->wakeHandler_();
+    }
+
     /**
      * @brief Boucle principale du thread d'écoute
      *
@@ -73,13 +199,15 @@ class Communication {
     Communication& operator=(Communication&&) = delete;
 
     /**
-     * @brief Tente de se connecter au socket du moteur
+     * @brief Tente de se connecter au socket du moteur ; les touches tenues
+     * avant la coupure sont relâchées
      * @return `true` en cas de succès, `false` sinon
      */
     [[nodiscard]] bool connect();
 
     /**
-     * @brief Se déconnecte du socket et arrête le thread d'écoute
+     * @brief Se déconnecte du socket, arrête le thread d'écoute et relâche
+     * les touches du piano réel
      */
     void disconnect();
 
@@ -102,10 +230,79 @@ class Communication {
      */
     [[nodiscard]] std::optional<Message> popMessage();
 
+    /**
+     * @brief Relève les touches du piano réel, coalescées depuis le relevé
+     * précédent, et oublie les frappes relevées
+     * @param states Reçoit touches enfoncées, frappes et vélocités
+     * @return `false` si aucun `noteon`/`noteoff` n'est arrivé entre-temps
+     */
+    [[nodiscard]] bool takeKeyStates(KeyStates& states);
+
     /**
      * @brief Vide la file d'attente des messages reçus
      */
     void clearQueue();
+
+    /**
+     * @brief Compte les messages reçus en attente de traitement
+     * @return Taille de la file
+     */
+    [[nodiscard]] size_t queueDepth();
+
+    /**
+     * @brief Configure le battement de cœur `ping`/`pong` (avant `connect`)
+     * @param interval Intervalle entre deux `ping`, 0 pour désactiver
+     * @param stallDeadline Délai sans `pong` au-delà duquel le moteur est
+     * considéré bloqué
+     */
+    void setHeartbeat(std::chrono::milliseconds interval,
+                      std::chrono::milliseconds stallDeadline);
+
+    /**
+     * @brief Configure l'affinité et la priorité du thread d'écoute (avant
+     * `connect`)
+     * @param policy Politique appliquée au démarrage du thread
+     */
+    void setThreadPolicy(const ThreadPolicy& policy) {
+        this->ioPolicy_ = policy;
+    }
+
+    /**
+     * @brief Configure le réveil de l'interface (avant `connect`)
+     * @param handler Fonction thread-safe appelée depuis le thread d'écoute à
+     * chaque message mis en file, blocage détecté ou fermeture du lien
+     */
+    void setWakeHandler(std::function<void()> handler) {
+        this->wakeHandler_ = std::move(handler);
+    }
+
+    /**
+     * @brief Remplace le socket par un lien simulé (avant `connect`) :
+     * `connect` réussit sans moteur, les envois vont au gestionnaire et les
+     * réceptions viennent de `inject`
+     * @param handler Reçoit chaque message envoyé, vide pour revenir au socket
+     */
+    void setLoopback(std::function<void(const Message&)> handler) {
+        this->loopback_ = std::move(handler);
+    }
+
+    /**
+     * @brief Met un message en file comme s'il venait du moteur
+     * @param msg Message reçu
+     */
+    void inject(Message msg);
+
+    /**
+     * @brief Indique si le moteur ne répond plus aux `ping`
+     * @return `true` si le délai de blocage est dépassé
+     */
+    [[nodiscard]] bool isStalled() const noexcept { return this->stalled_; }
+
+    /**
+     * @brief Renvoie un instantané des statistiques du lien
+     * @return Compteurs, percentiles et histogramme des RTT
+     */
+    [[nodiscard]] LinkStats linkStats() const;
 };
 
 #endif // CODE_UI_INCLUDE_COMMUNICATION_HPP_
@@ -0,0 +1,191 @@
+#ifndef CODE_UI_INCLUDE_DRAWLIST_HPP_
+#define CODE_UI_INCLUDE_DRAWLIST_HPP_
+
+#include "LayerCache.hpp"
+#include "TextCache.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// Nature d'une commande de dessin
+enum class DrawOp : uint8_t {
+    RECT,         ///< Rectangle plein
+    RECT_LINES,   ///< Contour de rectangle
+    LINE,         ///< Segment épais
+    ELLIPSE,      ///< Ellipse pleine
+    CIRCLE_LINES, ///< Contour de cercle
+    TEXTURE,      ///< Texture mise à l'échelle
+    QUADS,        ///< Quads texturés consécutifs : textes, notes qui tombent
+    PLAIN_TEXT,   ///< Texte non préparé, dessiné par `DrawText`
+    LAYER         ///< Couche en cache, suivie de son contenu s'il a changé
+};
+
+/// Quad texturé aligné sur les axes, en coordonnées écran
+struct DrawQuad {
+    Rectangle dest;
+    float u0, v0, u1, v1; ///< Coordonnées normalisées dans la texture
+    Color color;
+};
+
+/**
+ * @brief Commande de dessin ; les champs lus dépendent de `op`
+ *
+ * Formes : `rect` (ligne de `(x, y)` à `(width, height)`, ellipse et cercle
+ * centrés en `(x, y)` de rayons `width` et `height`). Quads, texte et couche
+ * désignent une plage `[first, first + count[` des tableaux de la liste.
+ */
+struct DrawCommand {
+    DrawOp op{DrawOp::RECT};
+    Color color{};
+    float thick{0.0f}; ///< Épaisseur du trait, ou échelle d'une texture
+    int32_t size{0};   ///< Taille d'un texte non préparé
+    Rectangle rect{};
+    Texture2D texture{};
+    uint32_t first{0};
+    uint32_t count{0};
+    CachedLayer* layer{nullptr};
+    uint64_t key{0};
+};
+
+/**
+ * @brief Liste des commandes de dessin d'une image : enregistrée sans appel
+ * OpenGL, donc hors du thread de la fenêtre, puis soumise à raylib par le
+ * thread qui détient le contexte
+ *
+ * Les tableaux gardent leur capacité d'une image à l'autre : une fois
+ * réchauffée, une liste s'enregistre sans allocation. Les textes préparés
+ * sont recopiés quad par quad, la liste ne dépend donc plus du cache de
+ * textes une fois enregistrée.
+ */
+class DrawList {
+  private:
+    std::vector<DrawCommand> commands_;
+    std::vector<DrawQuad> quads_;
+    std::vector<char> chars_; ///< Textes non préparés, terminés par '\0'
+    size_t sealed_{0};        ///< Fin de la dernière couche : pas de fusion
+
+    /**
+     * @brief Ajoute une commande
+     * @param op Nature
+     * @param color Couleur
+     * @return Commande à compléter
+     */
+    DrawCommand& push(DrawOp op, Color color);
+
+    /**
+     * @brief Commande de quads recevant les suivants : la dernière si elle
+     * utilise la même texture, une nouvelle sinon
+     * @param texture Identifiant OpenGL de la texture
+     * @return Commande de quads
+     */
+    DrawCommand& quadRun(uint32_t texture);
+
+    /**
+     * @brief Soumet une plage de commandes à raylib
+     * @param first Première commande
+     * @param end Fin de la plage
+     * @param probe Sonde du lot actif, vide hors mesure
+     */
+    void replay(size_t first, size_t end, const BatchProbe& probe) const;
+
+  public:
+    /// Capacités réservées : une image chargée, HUD compris, sans réallocation
+    static constexpr size_t COMMAND_CAPACITY{2048};
+    static constexpr size_t QUAD_CAPACITY{4096};
+    static constexpr size_t CHAR_CAPACITY{1024};
+
+    DrawList();
+
+    /**
+     * @brief Vide la liste, capacités conservées
+     */
+    void clear() noexcept;
+
+    void rect(Rectangle rec, Color color);
+    void rectLines(Rectangle rec, float thick, Color color);
+    void line(Vector2 start, Vector2 end, float thick, Color color);
+    void ellipse(Vector2 center, float radiusH, float radiusV, Color color);
+    void circleLines(Vector2 center, float radius, Color color);
+    void texture(Texture2D texture, Vector2 pos, float scale, Color tint);
+
+    /**
+     * @brief Rectangle plein en quad sur la texture des formes de raylib : des
+     * rectangles consécutifs partagent un seul lot
+     * @param rec Rectangle
+     * @param color Couleur
+     */
+    void solid(Rectangle rec, Color color);
+
+    /**
+     * @brief Texte préparé, recopié dans la liste
+     * @param run Texte préparé
+     * @param pos Coin haut gauche
+     * @param color Couleur
+     */
+    void text(const TextRun& run, Vector2 pos, Color color);
+
+    /**
+     * @brief Texte préparé centré horizontalement
+     * @param run Texte préparé
+     * @param anchor Milieu du bord haut du texte
+     * @param color Couleur
+     */
+    void textCentered(const TextRun& run, Vector2 anchor, Color color) {
+        this->text(run, {anchor.x - run.width / 2.0f, anchor.y}, color);
+    }
+
+    /**
+     * @brief Texte non préparé, pour ce qui change à chaque image et
+     * viderait le cache de textes
+     * @param text Texte
+     * @param pos Coin haut gauche
+     * @param size Taille en pixels
+     * @param color Couleur
+     */
+    void plainText(std::string_view text, Vector2 pos, int32_t size,
+                   Color color);
+
+    /**
+     * @brief Couche statique : son contenu n'est enregistré que si
+     * l'empreinte ou la zone ont changé, ou si la texture a été perdue
+     * @param layer Couche, recopiée au moment de la soumission
+     * @param bounds Zone de l'écran couverte
+     * @param key Empreinte des entrées de la couche
+     * @param render Enregistrement du contenu, en coordonnées écran
+     */
+    template <typename Fn>
+    void layer(CachedLayer& layer, Rectangle bounds, const LayerKey& key,
+               Fn&& render) {
+        size_t at = this->commands_.size();
+        DrawCommand& cmd = this->push(DrawOp::LAYER, BLANK);
+        cmd.layer = &layer;
+        cmd.rect = bounds;
+        cmd.key = key.value();
+        cmd.first = static_cast<uint32_t>(at + 1);
+        if (!layer.needsContent(bounds, key.value())) return;
+        render();
+        // `cmd` a pu être invalidée par l'enregistrement du contenu
+        this->commands_[at].count =
+            static_cast<uint32_t>(this->commands_.size() - at - 1);
+        this->sealed_ = this->commands_.size();
+    }
+
+    /**
+     * @brief Soumet toute la liste à raylib ; thread du contexte OpenGL, entre
+     * `BeginDrawing` et `EndDrawing` (ou dans une texture de rendu)
+     * @param probe Sonde du lot actif, prévenue avant chaque commande et
+     * chaque envoi forcé du lot ; vide hors mesure
+     */
+    void submit(const BatchProbe& probe = {}) const;
+
+    [[nodiscard]] const std::vector<DrawCommand>& commands() const noexcept {
+        return this->commands_;
+    }
+
+    [[nodiscard]] const std::vector<DrawQuad>& quads() const noexcept {
+        return this->quads_;
+    }
+};
+
+#endif // CODE_UI_INCLUDE_DRAWLIST_HPP_
@@ -0,0 +1,92 @@
+#ifndef CODE_UI_INCLUDE_FALLINGNOTES_HPP_
+#define CODE_UI_INCLUDE_FALLINGNOTES_HPP_
+
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Notes des défis tombant vers le clavier virtuel, colorées par le
+ * résultat : réserve de taille fixe en tableaux parallèles, passes de mise à
+ * jour vectorisables, compaction par échange avec la dernière, sans
+ * allocation ; dessinées en un seul lot
+ *
+ * Les notes actives occupent `[0, count_[` ; une note retirée est remplacée
+ * par la dernière. Les positions sont en blanches depuis la0 et en part de la
+ * hauteur de chute, converties à l'écran au rendu selon la fenêtre du clavier.
+ */
+class FallingNotes {
+  public:
+    static constexpr size_t CAPACITY{512};  ///< Notes à l'écran au plus
+    static constexpr float FALL_TIME{1.5f}; ///< Secondes du haut au clavier
+    static constexpr float FADE_TIME{0.8f}; ///< Disparition après le résultat
+    static constexpr float LENGTH{0.08f};   ///< Hauteur d'une note / chute
+
+  private:
+    std::array<float, CAPACITY> lane_{};  ///< Bord gauche, en blanches
+    std::array<float, CAPACITY> width_{}; ///< Largeur, en blanches
+    std::array<float, CAPACITY> fall_{};  ///< Bas de la note, 1 au clavier
+    std::array<float, CAPACITY> life_{};  ///< Opacité restante
+    std::array<float, CAPACITY> decay_{}; ///< Par seconde, 0 sans résultat
+    std::array<int16_t, CAPACITY> midi_{};
+    std::array<Color, CAPACITY> color_{};
+    size_t count_{0};
+    uint32_t dropped_{0}; ///< Notes refusées, réserve pleine
+
+    /**
+     * @brief Ajoute une note à la réserve
+     * @param midi Numéro MIDI, ignoré hors du piano
+     * @param fall Hauteur de départ, 0 en haut
+     * @param color Couleur
+     * @return `false` si la note est ignorée ou la réserve pleine
+     */
+    bool spawn(int32_t midi, float fall, Color color);
+
+    /**
+     * @brief Marque une note résolue : couleur finale, puis disparition
+     * @param i Rang dans la réserve
+     * @param color Couleur du résultat
+     */
+    void resolve(size_t i, Color color);
+
+  public:
+    /**
+     * @brief Fait tomber les notes d'un nouveau défi ; celles d'un défi
+     * resté sans résultat sont comptées manquées
+     * @param expected Notes attendues
+     * @param color Couleur des notes en attente (profil)
+     */
+    void setChallenge(const std::vector<std::string>& expected, Color color);
+
+    /**
+     * @brief Colore les notes du défi selon le résultat ; les fausses notes
+     * apparaissent au ras du clavier
+     * @param correct Notes justes
+     * @param incorrect Notes fausses
+     */
+    void setResult(const std::vector<std::string>& correct,
+                   const std::vector<std::string>& incorrect);
+
+    /**
+     * @brief Retire toutes les notes
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Avance la chute et les fondus, retire les notes éteintes
+     * @param dt Temps écoulé depuis l'image précédente, en secondes
+     * @return `true` si une note a bougé ou pâli
+     */
+    bool animate(float dt);
+
+    [[nodiscard]] size_t count() const noexcept { return this->count_; }
+
+    [[nodiscard]] uint32_t dropped() const noexcept { return this->dropped_; }
+
+    // Le rendu lit directement les tableaux
+    friend class UI;
+};
+
+#endif // CODE_UI_INCLUDE_FALLINGNOTES_HPP_
@@ -0,0 +1,74 @@
+#ifndef CODE_UI_INCLUDE_FRAMEARENA_HPP_
+#define CODE_UI_INCLUDE_FRAMEARENA_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * @brief Arène d'une image : chaînes et listes temporaires du dessin servies
+ * par un tampon monotone, remis à zéro au début de chaque image
+ *
+ * Ce qui déborde du tampon est pris sur le tas, puis le tampon est agrandi à
+ * la remise à zéro suivante : en régime établi, une image n'alloue plus rien.
+ * L'arène appartient au thread qui enregistre l'image ; rien de ce qui y est
+ * alloué ne doit survivre à l'image.
+ */
+class FrameArena {
+  private:
+    /// Ressource amont : sert et mesure les débordements du tampon
+    class Overflow final : public std::pmr::memory_resource {
+      private:
+        size_t bytes_{0}; ///< Octets débordés depuis la remise à zéro
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool
+        do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            override {
+            return this == &other;
+        }
+
+      public:
+        [[nodiscard]] size_t bytes() const noexcept { return this->bytes_; }
+        void clear() noexcept { this->bytes_ = 0; }
+    };
+
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_;
+    Overflow overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+
+  public:
+    static constexpr size_t DEFAULT_CAPACITY{16 * 1024};
+
+    /**
+     * @brief Réserve le tampon
+     * @param capacity Taille initiale du tampon en octets
+     */
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+    /**
+     * @brief Libère tout ce que l'image a alloué ; agrandit le tampon si
+     * l'image a débordé
+     */
+    void reset();
+
+    /**
+     * @brief Ressource à passer aux conteneurs `std::pmr` de l'image
+     * @return Ressource de l'arène, valable jusqu'au prochain `reset()`
+     */
+    [[nodiscard]] std::pmr::memory_resource* resource() noexcept {
+        return &*this->resource_;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return this->capacity_; }
+};
+
+#endif // CODE_UI_INCLUDE_FRAMEARENA_HPP_
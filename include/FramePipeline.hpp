@@ -0,0 +1,113 @@
+#ifndef CODE_UI_INCLUDE_FRAMEPIPELINE_HPP_
+#define CODE_UI_INCLUDE_FRAMEPIPELINE_HPP_
+
+#include "DrawList.hpp"
+#include "ThreadTuning.hpp"
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Listes de dessin en double tampon : l'image suivante s'enregistre
+ * sur un thread dédié pendant que le thread OpenGL soumet et présente la
+ * précédente
+ *
+ * Déroulé d'une image : `record()` lance l'enregistrement de l'état courant,
+ * `submit()` envoie la liste prête à raylib, `wait()` attend la fin de
+ * l'enregistrement, qui devient la liste prête. Entre `record()` et `wait()`,
+ * l'état lu par l'enregistreur ne doit pas être modifié. Sans thread,
+ * `record()` enregistre sur place et l'image est présentée aussitôt.
+ */
+class FramePipeline {
+  public:
+    /// Enregistre l'image courante dans une liste vide
+    using Recorder = std::function<void(DrawList&)>;
+
+  private:
+    std::array<DrawList, 2> lists_{};
+    size_t back_{0};       ///< Liste en cours d'enregistrement
+    bool recorded_{false}; ///< Liste avant valide (déjà enregistrée)
+    bool ready_{false};    ///< Liste avant pas encore soumise
+    bool inFlight_{false}; ///< `record()` sans `wait()` correspondant
+    Recorder recorder_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool requested_{false}; ///< Enregistrement demandé, pas encore terminé
+    bool stopping_{false};
+
+    /**
+     * @brief Boucle du thread : enregistre à chaque demande
+     * @param policy Affinité et priorité du thread
+     */
+    void work(ThreadPolicy policy);
+
+    /**
+     * @brief Enregistrement terminé : la liste arrière passe à l'avant
+     */
+    void flip() noexcept;
+
+  public:
+    FramePipeline() = default;
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+    FramePipeline(FramePipeline&&) = delete;
+    FramePipeline& operator=(FramePipeline&&) = delete;
+
+    /**
+     * @brief Définit l'enregistrement d'une image ; thread arrêté
+     * @param recorder Appelé sur le thread d'enregistrement
+     */
+    void setRecorder(Recorder recorder);
+
+    /**
+     * @brief Lance le thread d'enregistrement
+     * @param policy Affinité et priorité du thread
+     */
+    void start(ThreadPolicy policy);
+
+    /**
+     * @brief Arrête le thread après l'image en cours ; enregistrement sur
+     * place ensuite
+     */
+    void stop();
+
+    [[nodiscard]] bool threaded() const noexcept {
+        return this->worker_.joinable();
+    }
+
+    /**
+     * @brief Lance l'enregistrement de l'image courante
+     */
+    void record();
+
+    /**
+     * @brief Attend la fin de l'enregistrement lancé par `record()`
+     */
+    void wait();
+
+    /**
+     * @brief Soumet la liste avant à raylib, thread du contexte OpenGL ; sans
+     * nouvelle liste, l'image précédente est soumise à nouveau
+     * @return `true` si la liste n'avait pas encore été soumise
+     */
+    bool submit();
+
+    /**
+     * @brief Écarte la liste avant sans la soumettre (rejeu sans fenêtre)
+     */
+    void discard() noexcept { this->ready_ = false; }
+
+    /**
+     * @brief Indique si une liste attend d'être présentée
+     * @return `true` après un enregistrement non encore soumis
+     */
+    [[nodiscard]] bool ready() const noexcept { return this->ready_; }
+};
+
+#endif // CODE_UI_INCLUDE_FRAMEPIPELINE_HPP_
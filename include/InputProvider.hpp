@@ -0,0 +1,96 @@
+#ifndef CODE_UI_INCLUDE_INPUTPROVIDER_HPP_
+#define CODE_UI_INCLUDE_INPUTPROVIDER_HPP_
+
+#include "KeyboardModel.hpp"
+#include "raylib.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+/// Touches lues par l'application
+enum class InputKey : uint8_t {
+    BACKSPACE, ///< Effacement du nom saisi
+    ENTER,     ///< Validation du nom saisi
+    ESCAPE,    ///< Abandon de la saisie
+    LEFT,      ///< Clavier virtuel : une octave vers le grave
+    RIGHT,     ///< Clavier virtuel : une octave vers l'aigu
+    PROFILER,  ///< F3 : HUD du profileur
+    COUNT
+};
+
+/// Entrées d'une image, relevées en une fois avant la logique
+struct InputFrame {
+    static constexpr size_t MAX_KEY_EVENTS{64}; ///< Par image, au plus
+
+    double time{0.0}; ///< Horloge monotone (secondes)
+    float screenW{0.0f};
+    float screenH{0.0f};
+    Vector2 mouse{-1.0f, -1.0f}; ///< Pointeur, à l'échelle de la fenêtre
+    bool clicked{false};         ///< Bouton principal enfoncé dans l'image
+    float wheel{0.0f};           ///< Crans de molette
+    std::array<Pointer, KeyboardModel::MAX_POINTERS> pointers{};
+    size_t pointerCount{0}; ///< Doigts posés, ou la souris à défaut
+    std::string typed;      ///< Caractères saisis dans l'image
+    std::bitset<static_cast<size_t>(InputKey::COUNT)> keys; ///< Enfoncées
+    /// Appuis et relâchements des touches depuis l'image précédente, datés à
+    /// leur arrivée et non au relevé
+    std::array<KeyEvent, MAX_KEY_EVENTS> keyEvents{};
+    size_t keyEventCount{0};
+    bool activity{false}; ///< Saisie depuis l'image précédente : redessiner
+    bool quit{false};     ///< Fermeture demandée
+
+    [[nodiscard]] bool pressed(InputKey key) const {
+        return this->keys.test(static_cast<size_t>(key));
+    }
+};
+
+/**
+ * @brief Source des entrées et de l'horloge de la boucle principale : raylib
+ * par défaut, scénario rejoué pour les tests et les benchmarks
+ */
+class InputProvider {
+  public:
+    virtual ~InputProvider() = default;
+
+    /**
+     * @brief Relève les entrées de l'image courante
+     * @param frame Entrées, réécrites en entier
+     */
+    virtual void poll(InputFrame& frame) = 0;
+
+    /**
+     * @brief Attend un événement sans rien dessiner
+     * @param seconds Attente maximale
+     */
+    virtual void wait(double seconds) = 0;
+
+    /**
+     * @brief Signale une image dessinée ; le cadencement de `EndDrawing`
+     * suffit à raylib
+     */
+    virtual void present() {}
+
+    /**
+     * @brief Lit l'horloge
+     * @return Secondes, horloge monotone
+     */
+    [[nodiscard]] virtual double now() const = 0;
+};
+
+/**
+ * @brief Entrées de la fenêtre raylib : souris, écran tactile et clavier ;
+ * les touches sont aussi relevées par un rappel GLFW chaîné à celui de
+ * raylib, qui les date à leur arrivée
+ */
+class RaylibInput : public InputProvider {
+  private:
+    bool hooked_{false}; ///< Rappel des touches installé
+
+  public:
+    void poll(InputFrame& frame) override;
+    void wait(double seconds) override;
+    [[nodiscard]] double now() const override;
+};
+
+#endif // CODE_UI_INCLUDE_INPUTPROVIDER_HPP_
@@ -0,0 +1,66 @@
+#ifndef CODE_UI_INCLUDE_KEYSTATES_HPP_
+#define CODE_UI_INCLUDE_KEYSTATES_HPP_
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Touches du piano réel, coalescées entre deux images : les `noteon` et
+ * `noteoff` du moteur n'y laissent que l'état final de chaque touche, plus les
+ * frappes survenues depuis le relevé précédent (même déjà relâchées)
+ */
+struct KeyStates {
+    static constexpr size_t NOTES{128}; ///< Numéros MIDI
+
+    std::bitset<NOTES> held;               ///< Touches enfoncées
+    std::bitset<NOTES> struck;             ///< Frappées depuis le relevé
+    std::array<uint8_t, NOTES> velocity{}; ///< Vélocité de la dernière frappe
+    uint32_t events{0};                    ///< Événements depuis le relevé
+
+    /**
+     * @brief Enregistre une frappe
+     * @param midi Numéro MIDI, ignoré hors de [0, 127]
+     * @param vel Vélocité de 1 à 127 ; 0 vaut un relâchement (MIDI)
+     */
+    void noteOn(int32_t midi, uint8_t vel) {
+        if (midi < 0 || static_cast<size_t>(midi) >= NOTES) return;
+        ++this->events;
+        if (vel == 0) {
+            this->held.reset(static_cast<size_t>(midi));
+            return;
+        }
+        this->held.set(static_cast<size_t>(midi));
+        this->struck.set(static_cast<size_t>(midi));
+        this->velocity[static_cast<size_t>(midi)] = vel;
+    }
+
+    /**
+     * @brief Enregistre un relâchement
+     * @param midi Numéro MIDI, ignoré hors de [0, 127]
+     */
+    void noteOff(int32_t midi) { this->noteOn(midi, 0); }
+
+    /**
+     * @brief Relâche toutes les touches, le lien perdu ne transmettra plus
+     * leurs `noteoff` ; compte un événement pour que le relevé suivant les
+     * reporte
+     */
+    void releaseAll() {
+        if (this->held.none()) return;
+        this->held.reset();
+        ++this->events;
+    }
+
+    /**
+     * @brief Oublie frappes et compte d'événements, après un relevé ; les
+     * touches enfoncées le restent
+     */
+    void acknowledge() {
+        this->struck.reset();
+        this->events = 0;
+    }
+};
+
+#endif // CODE_UI_INCLUDE_KEYSTATES_HPP_
@@ -0,0 +1,338 @@
+#ifndef CODE_UI_INCLUDE_KEYBOARDMODEL_HPP_
+#define CODE_UI_INCLUDE_KEYBOARDMODEL_HPP_
+
+#include "ChordGrouper.hpp"
+#include "KeyStates.hpp"
+#include "PianoKeymap.hpp"
+#include "Types.hpp"
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// Pointeur sur l'écran : doigt ou souris
+struct Pointer {
+    int32_t id{-1}; ///< Identifiant du doigt, -1 pour la souris
+    Vector2 position{};
+    bool down{false}; ///< Doigt posé ou bouton principal enfoncé
+};
+
+/// Appui ou relâchement d'une touche du clavier de l'ordinateur, horodaté
+struct KeyEvent {
+    int32_t key{0};   ///< Code raylib de la touche (position QWERTY)
+    bool down{false}; ///< `true` à l'appui, `false` au relâchement
+    double time{0.0}; ///< Instant de l'événement, horloge monotone (secondes)
+};
+
+/**
+ * @brief Clavier virtuel persistant couvrant tout le piano : états et couleurs
+ * des 88 touches en tableaux parallèles, recalculés seulement quand un défi,
+ * un résultat ou la saisie change ; seules les touches de la fenêtre visible,
+ * défilable et zoomable, sont positionnées et dessinées
+ */
+class KeyboardModel {
+  public:
+    static constexpr int32_t NUM_WHITE{52}; ///< La0 à do8
+    static constexpr int32_t NUM_BLACK{36};
+    static constexpr int32_t FIRST_MIDI{21};  ///< La0
+    static constexpr int32_t LAST_MIDI{108};  ///< Do8
+    static constexpr float MIN_VISIBLE{7.0f}; ///< Zoom maximal, en blanches
+    static constexpr size_t MAX_POINTERS{10}; ///< Doigts suivis à la fois
+
+    static constexpr Color BLACK_FILL{30, 60, 30, 255}; ///< Noire au repos
+
+    /// États d'une touche, combinables
+    enum KeyFlag : uint8_t {
+        KEY_PRESSED = 1U << 0U,
+        KEY_HOVER = 1U << 1U,
+        KEY_EXPECTED = 1U << 2U,
+        KEY_CORRECT = 1U << 3U,
+        KEY_WRONG = 1U << 4U,
+        KEY_LIVE = 1U << 5U ///< Enfoncée sur le piano réel
+    };
+
+  private:
+    // Paramètres de disposition et de style
+    float screenW_{0.0f};
+    float screenH_{0.0f};
+    int32_t numKeys_{0}; ///< Blanches visibles par défaut du type de jeu
+    Color userColor_{WHITE};
+    NotationMode notation_{NotationMode::SYLLABIC};
+
+    // Fenêtre visible, en blanches depuis la0, et cible vers laquelle elle
+    // glisse
+    float viewStart_{23.0f}; ///< Do4 au bord gauche
+    float viewWidth_{MIN_VISIBLE};
+    float targetStart_{23.0f};
+    float targetWidth_{MIN_VISIBLE};
+    float keyWidth_{0.0f};  ///< Largeur d'une blanche à l'écran
+    int32_t firstWhite_{0}; ///< Blanches visibles : [firstWhite_, endWhite_[
+    int32_t endWhite_{0};
+    int32_t firstBlack_{0}; ///< Noires visibles : [firstBlack_, endBlack_[
+    int32_t endBlack_{0};
+    bool showLabels_{false}; ///< Touches assez larges pour leur libellé
+
+    /// Touche tenue par un pointeur
+    struct Hold {
+        int32_t pointer{-1}; ///< Identifiant du pointeur
+        int32_t midi{-1};    ///< Touche sous le pointeur, -1 hors clavier
+
+        bool operator==(const Hold&) const = default;
+    };
+
+    // Saisie courante (-1 : aucune touche)
+    int32_t hoverMidi_{-1}; ///< Touche survolée par la souris sans appui
+    std::array<Hold, MAX_POINTERS> holds_{};
+    size_t holdCount_{0};
+    uint16_t pressedPitchClasses_{0}; ///< Bit n : classe de hauteur n enfoncée
+    ChordGrouper chords_;
+
+    // Clavier de l'ordinateur : note tenue par chaque touche jouable (-1 :
+    // relâchée), gardée jusqu'au relâchement même si la fenêtre défile
+    PianoKeymap keymap_;
+    std::array<int8_t, PianoKeymap::SLOTS> typed_{};
+
+    // Touches blanches ; rectangles à jour pour les visibles seulement
+    std::array<Rectangle, NUM_WHITE> whiteRect_{};
+    std::array<uint8_t, NUM_WHITE> whiteFlags_{};
+    std::array<Color, NUM_WHITE> whiteFill_{};
+    std::array<Color, NUM_WHITE> whiteText_{};
+    std::array<std::string, NUM_WHITE> whiteLabel_{};
+    std::array<Vector2, NUM_WHITE> whiteLabelPos_{}; ///< Milieu haut du texte
+
+    // Touches noires ; rectangles à jour pour les visibles seulement
+    std::array<Rectangle, NUM_BLACK> blackRect_{};
+    std::array<uint8_t, NUM_BLACK> blackFlags_{};
+    std::array<Color, NUM_BLACK> blackFill_{};
+
+    // Éclat des touches frappées sur le piano réel : vélocité à la frappe,
+    // puis déclin, plus rapide une fois la touche relâchée
+    std::array<float, NUM_WHITE> whiteLive_{};
+    std::array<float, NUM_BLACK> blackLive_{};
+
+    // Lettres du clavier de l'ordinateur sur les touches (0 : aucune) ;
+    // positions à jour pour les visibles seulement
+    std::array<char, NUM_WHITE> whiteHint_{};
+    std::array<Vector2, NUM_WHITE> whiteHintPos_{}; ///< Milieu haut du texte
+    std::array<char, NUM_BLACK> blackHint_{};
+    std::array<Vector2, NUM_BLACK> blackHintPos_{};
+    int32_t hintBase_{-1};  ///< Do de départ des lettres, -1 sans lettres
+    bool showHints_{false}; ///< Touches assez larges pour leur lettre
+
+    /**
+     * @brief Recalcule rectangles et position des libellés des touches
+     * visibles
+     */
+    void layout();
+
+    /**
+     * @brief Recalcule les libellés des blanches selon la notation
+     */
+    void relabel();
+
+    /**
+     * @brief Recalcule les lettres du clavier de l'ordinateur affichées sur
+     * les touches, sans effet si le do de départ n'a pas changé
+     */
+    void rehint();
+
+    /**
+     * @brief Recalcule les couleurs de remplissage depuis les drapeaux
+     */
+    void recolor();
+
+    /**
+     * @brief Repose survol et appuis (pointeurs et clavier de l'ordinateur),
+     * puis recalcule les couleurs
+     */
+    void reflag();
+
+    /**
+     * @brief Efface un drapeau sur toutes les touches
+     * @param flag Drapeau à effacer
+     */
+    void clearFlag(uint8_t flag);
+
+    /**
+     * @brief Pose un drapeau sur les touches correspondant à des notes
+     * @param notes Notes (ex : "c4", "eb4")
+     * @param flag Drapeau à poser
+     */
+    void markNotes(const std::vector<std::string>& notes, uint8_t flag);
+
+    /**
+     * @brief Fait décliner l'éclat des touches du piano réel
+     * @param dt Temps écoulé depuis l'image précédente, en secondes
+     * @return `true` si un éclat a changé
+     */
+    bool fadeLive(float dt);
+
+    /**
+     * @brief Borne la fenêtre cible au clavier
+     */
+    void clampTarget();
+
+    /**
+     * @brief Do joué par la première touche du clavier de l'ordinateur : le
+     * premier do de la fenêtre cible
+     * @return Numéro MIDI
+     */
+    [[nodiscard]] int32_t typedBase() const;
+
+    /**
+     * @brief Touche sous un point, sans parcourir les rectangles
+     * @param point Position à l'écran
+     * @return Numéro MIDI, -1 hors du clavier visible
+     */
+    [[nodiscard]] int32_t keyAt(Vector2 point) const;
+
+    /**
+     * @brief Pose des drapeaux sur une touche
+     * @param midi Numéro MIDI, ignoré hors du piano
+     * @param flags Drapeaux à poser
+     */
+    void flagKey(int32_t midi, uint8_t flags);
+
+  public:
+    KeyboardModel();
+
+    /**
+     * @brief Adapte la géométrie, sans effet si rien n'a changé
+     * @param numKeys Nombre de blanches visibles par défaut du type de jeu
+     * @param screenW Largeur de la fenêtre
+     * @param screenH Hauteur de la fenêtre
+     */
+    void setLayout(int32_t numKeys, float screenW, float screenH);
+
+    /**
+     * @brief Adapte couleur du profil et notation, sans effet si inchangées
+     * @param userColor Couleur du profil actif (touches enfoncées, survol)
+     * @param notation Notation des libellés
+     */
+    void setStyle(Color userColor, NotationMode notation);
+
+    /**
+     * @brief Marque les touches attendues et fait glisser la fenêtre pour les
+     * montrer toutes
+     * @param expected Notes attendues du défi, vide hors défi
+     */
+    void setChallenge(const std::vector<std::string>& expected);
+
+    /**
+     * @brief Marque les touches justes et fausses du dernier résultat
+     * @param correct Notes justes
+     * @param incorrect Notes fausses
+     */
+    void setResult(const std::vector<std::string>& correct,
+                   const std::vector<std::string>& incorrect);
+
+    /**
+     * @brief Efface le marquage du dernier résultat
+     */
+    void clearResult();
+
+    /**
+     * @brief Met à jour survol et appuis de tous les pointeurs en une passe ;
+     * chaque nouvelle touche sous un doigt (appui ou glissé) est un appui
+     * horodaté, regroupé en accord avec ses voisins immédiats
+     * @param pointers Doigts posés, ou souris seule sans écran tactile
+     * @param enabled `false` pour ignorer les pointeurs (pause, clavier masqué)
+     * @param now Instant courant, horloge monotone (secondes)
+     */
+    void setPointers(std::span<const Pointer> pointers, bool enabled,
+                     double now);
+
+    /**
+     * @brief Choisit la disposition du clavier de l'ordinateur ; les touches
+     * tenues sont relâchées
+     * @param layout Disposition, `KeyLayout::NONE` pour l'ignorer
+     */
+    void setKeymap(KeyLayout layout);
+
+    /**
+     * @brief Applique en une passe les appuis et relâchements du clavier de
+     * l'ordinateur : autant de touches tenues à la fois que le clavier en
+     * transmet, chaque appui horodaté regroupé en accord comme ceux des
+     * pointeurs. À appeler avant `setPointers`, dont les appuis sont plus
+     * récents
+     * @param events Événements de l'image, dans l'ordre chronologique
+     * @param enabled `false` pour les ignorer et relâcher les touches tenues
+     * @return Instant du premier appui de l'image, -1 s'il n'y en a pas
+     */
+    double setTypedKeys(std::span<const KeyEvent> events, bool enabled);
+
+    /**
+     * @brief Reporte les touches du piano réel : enfoncées, et éclat des
+     * frappes selon leur vélocité
+     * @param states Relevé coalescé depuis l'image précédente
+     */
+    void setLiveKeys(const KeyStates& states);
+
+    /**
+     * @brief Retire le plus ancien accord joué au clavier virtuel
+     * @param chord Accord lu, appuis horodatés
+     * @return `false` si aucun accord n'est complet
+     */
+    bool takeChord(Chord& chord) { return this->chords_.pop(chord); }
+
+    /**
+     * @brief Délai avant qu'un accord en cours de saisie soit complet
+     * @param now Instant courant
+     * @return Secondes restantes, 0 sans accord en cours
+     */
+    [[nodiscard]] double chordTimeLeft(double now) const {
+        return this->chords_.timeLeft(now);
+    }
+
+    /**
+     * @brief Zoome autour d'une abscisse
+     * @param steps Crans de molette, positifs pour élargir les touches
+     * @param anchorX Abscisse qui reste sous le pointeur
+     */
+    void zoom(float steps, float anchorX);
+
+    /**
+     * @brief Fait défiler la fenêtre
+     * @param whites Décalage en blanches, positif vers les aigus
+     */
+    void scroll(float whites);
+
+    /**
+     * @brief Rapproche la fenêtre de sa cible (défilement et zoom lissés) et
+     * fait décliner l'éclat des touches du piano réel
+     * @param dt Temps écoulé depuis l'image précédente, en secondes
+     * @return `true` si la fenêtre ou une touche a changé
+     */
+    bool animate(float dt);
+
+    /**
+     * @brief Place d'une touche sur tout le piano, visible ou non
+     * @param midi Numéro MIDI
+     * @return Bord gauche (`x`) et largeur (`y`), en blanches depuis la0 ;
+     * largeur nulle hors du piano
+     */
+    [[nodiscard]] static Vector2 keySpan(int32_t midi);
+
+    /**
+     * @brief Rectangle d'une touche à l'écran, selon la fenêtre courante
+     * @param midi Numéro MIDI
+     * @return Rectangle ; largeur nulle hors du piano, hors de la fenêtre
+     * visible ou avant la première disposition
+     */
+    [[nodiscard]] Rectangle keyBounds(int32_t midi) const;
+
+    /**
+     * @brief Classes de hauteur des touches enfoncées
+     * @return Bit n posé si une touche de classe n (0 = do) est enfoncée
+     */
+    [[nodiscard]] uint16_t pressedPitchClasses() const noexcept {
+        return this->pressedPitchClasses_;
+    }
+
+    // Le rendu lit directement les tableaux
+    friend class UI;
+};
+
+#endif // CODE_UI_INCLUDE_KEYBOARDMODEL_HPP_
@@ -0,0 +1,157 @@
+#ifndef CODE_UI_INCLUDE_LAYERCACHE_HPP_
+#define CODE_UI_INCLUDE_LAYERCACHE_HPP_
+
+#include "raylib.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Sonde du lot de rendu actif, pour les mesures : appelée avant chaque
+ * commande rejouée (`false`) et juste avant chaque envoi forcé du lot
+ * (`true` : changement de cible ou de mode de fusion)
+ */
+using BatchProbe = std::function<void(bool flushing)>;
+
+/// Empreinte (FNV-1a) des entrées d'une couche : toute variation la redessine
+class LayerKey {
+  private:
+    uint64_t hash_{14695981039346656037ULL};
+
+  public:
+    /**
+     * @brief Ajoute des octets à l'empreinte
+     * @param data Début des octets
+     * @param size Nombre d'octets
+     * @return L'empreinte, pour chaîner les ajouts
+     */
+    LayerKey& addBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            this->hash_ = (this->hash_ ^ bytes[i]) * 1099511628211ULL;
+        }
+        return *this;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    LayerKey& add(const T& value) {
+        return this->addBytes(&value, sizeof(value));
+    }
+
+    LayerKey& add(std::string_view text) {
+        return this->add(text.size()).addBytes(text.data(), text.size());
+    }
+
+    LayerKey& add(const char* text) {
+        return this->add(std::string_view(text));
+    }
+
+    [[nodiscard]] uint64_t value() const noexcept { return this->hash_; }
+};
+
+/**
+ * @brief Couche statique rendue une fois dans une texture, puis recopiée à
+ * chaque image tant que son empreinte et sa zone ne changent pas
+ *
+ * Enregistrée dans une `DrawList` : le thread qui enregistre ne fournit le
+ * contenu que s'il a changé depuis son dernier envoi, le thread OpenGL le
+ * rend dans la texture à la soumission.
+ */
+class CachedLayer {
+  private:
+    // Côté soumission (thread OpenGL)
+    RenderTexture2D target_{};
+    Rectangle bounds_{};
+    uint64_t key_{0};
+    bool valid_{false};
+
+    // Côté enregistrement
+    Rectangle recordedBounds_{};
+    uint64_t recordedKey_{0};
+    /// Contenu à réenregistrer : texture perdue, invalidée ou jamais rendue
+    std::atomic<bool> stale_{true};
+
+    /**
+     * @brief Prépare le rendu dans la texture, (ré)allouée si la zone change
+     * @param bounds Zone de l'écran couverte par la couche
+     * @return `false` si la texture n'a pas pu être allouée
+     */
+    bool begin(Rectangle bounds);
+
+    /**
+     * @brief Termine le rendu dans la texture
+     */
+    void end();
+
+    /**
+     * @brief Recopie la texture à sa place sur l'écran
+     * @param probe Sonde du lot, prévenue avant chaque envoi ; vide hors
+     * mesure
+     */
+    void composite(const BatchProbe& probe = {}) const;
+
+    /**
+     * @brief Indique si la texture contient déjà cette couche
+     * @param bounds Zone de l'écran couverte
+     * @param key Empreinte des entrées
+     * @return `true` si une simple recopie suffit
+     */
+    [[nodiscard]] bool holds(Rectangle bounds, uint64_t key) const noexcept {
+        return this->valid_ && key == this->key_ &&
+               std::memcmp(&bounds, &this->bounds_, sizeof(bounds)) == 0;
+    }
+
+    /**
+     * @brief Côté enregistrement : le contenu doit-il accompagner la couche ?
+     * @param bounds Zone de l'écran couverte
+     * @param key Empreinte des entrées
+     * @return `true` si l'empreinte, la zone ou la texture ont changé depuis
+     * le dernier contenu fourni
+     */
+    bool needsContent(Rectangle bounds, uint64_t key) noexcept;
+
+  public:
+    /**
+     * @brief Force le prochain rendu
+     */
+    void invalidate() noexcept {
+        this->valid_ = false;
+        this->stale_ = true;
+    }
+
+    /**
+     * @brief Libère la texture ; à appeler avant la fermeture de la fenêtre
+     */
+    void release();
+
+    // Enregistrement et soumission des couches
+    friend class DrawList;
+};
+
+/// Couches statiques de l'interface
+enum class Layer { STAFF, MENU, KEYBOARD, COUNT };
+
+/// Ensemble des couches mises en cache
+class LayerCache {
+  private:
+    std::array<CachedLayer, static_cast<size_t>(Layer::COUNT)> layers_{};
+
+  public:
+    [[nodiscard]] CachedLayer& operator[](Layer layer) {
+        return this->layers_[static_cast<size_t>(layer)];
+    }
+
+    /**
+     * @brief Libère toutes les textures (avant `CloseWindow`)
+     */
+    void release() {
+        for (auto& layer : this->layers_) layer.release();
+    }
+};
+
+#endif // CODE_UI_INCLUDE_LAYERCACHE_HPP_
@@ -0,0 +1,149 @@
+#ifndef CODE_UI_INCLUDE_LAYOUT_HPP_
+#define CODE_UI_INCLUDE_LAYOUT_HPP_
+
+#include "Types.hpp"
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// Éléments d'interface positionnés par la mise en page, par écran
+enum class Widget : uint8_t {
+    PROFILE_CARD,     ///< Carte de profil (indexée)
+    PROFILE_DELETE,   ///< Suppression d'un profil (indexée)
+    PROFILE_ADD,      ///< Création d'un profil
+    MENU_GAME,        ///< Type de jeu (indexé)
+    MENU_SCALE,       ///< Tonique de la gamme (indexée, do à si)
+    MENU_MODE,        ///< Mode majeur / mineur (indexé)
+    MENU_SWITCH_USER, ///< Retour à la sélection de profil
+    MENU_KEYBOARD,    ///< Affichage du clavier virtuel
+    MENU_FALLING,     ///< Affichage des notes qui tombent
+    MENU_NOTATION,    ///< Notation des notes
+    PLAY_MENU,        ///< Abandon de la partie
+    PLAY_NEXT,        ///< Défi suivant
+    PLAY_PAUSE,       ///< Pause
+    PAUSE_PANEL,      ///< Cadre du menu de pause
+    PAUSE_RESUME,     ///< Reprise de la partie
+    PAUSE_QUIT,       ///< Abandon depuis la pause
+    GAME_OVER_BACK,   ///< Retour au menu en fin de partie
+    COUNT,
+    NONE = COUNT
+};
+
+/// Élément touché par un point
+struct Hit {
+    Widget widget{Widget::NONE};
+    int32_t index{0}; ///< Rang pour les éléments indexés
+
+    bool operator==(const Hit&) const = default;
+};
+
+/// Entrées de la mise en page : tout changement la recalcule
+struct LayoutInputs {
+    AppState state{AppState::PROFILE_SELECT};
+    float screenW{0.0f};
+    float screenH{0.0f};
+    size_t profiles{0};
+    size_t games{0};
+    bool paused{false};
+
+    bool operator==(const LayoutInputs&) const = default;
+};
+
+/**
+ * @brief Mise en page de l'écran courant : rectangles partagés par le rendu et
+ * la détection des clics, recalculés seulement au redimensionnement ou au
+ * changement d'état, et grille uniforme pour la détection des clics
+ */
+class Layout {
+  public:
+    static constexpr int32_t GRID{8}; ///< Cellules par côté de la grille
+
+  private:
+    /// Élément positionné
+    struct Placed {
+        Widget widget;
+        int32_t index;
+        Rectangle rect;
+    };
+
+    LayoutInputs inputs_{};
+    bool built_{false};
+    std::vector<Placed> placed_; ///< Ordre d'empilement : dernier au-dessus
+    /// Premier élément de chaque type dans `placed_`, -1 si absent
+    std::array<int32_t, static_cast<size_t>(Widget::COUNT)> first_{};
+    std::array<std::vector<uint16_t>, GRID * GRID> cells_{};
+    Hit hover_{};
+
+    /**
+     * @brief Ajoute un élément ; ceux d'un même type doivent se suivre
+     * @param widget Type d'élément
+     * @param index Rang de l'élément dans son type
+     * @param rect Rectangle à l'écran
+     */
+    void place(Widget widget, int32_t index, Rectangle rect);
+
+    void placeProfileSelect();
+    void placeMenu();
+    void placePlay();
+    void placeGameOver();
+
+    /**
+     * @brief Répartit les éléments dans les cellules qu'ils recouvrent
+     */
+    void buildIndex();
+
+    /**
+     * @brief Cellule de la grille contenant une abscisse ou une ordonnée
+     * @param value Coordonnée
+     * @param extent Largeur ou hauteur de l'écran
+     * @return Rang de cellule, borné à la grille
+     */
+    [[nodiscard]] static int32_t cellOf(float value, float extent);
+
+  public:
+    /**
+     * @brief Recalcule la mise en page si ses entrées ont changé
+     * @param inputs État, taille de l'écran et nombre d'éléments
+     * @return `true` si la mise en page a été recalculée
+     */
+    bool update(const LayoutInputs& inputs);
+
+    /**
+     * @brief Rectangle d'un élément de l'écran courant
+     * @param widget Type d'élément
+     * @param index Rang pour les éléments indexés
+     * @return Rectangle, vide si l'élément est absent
+     */
+    [[nodiscard]] Rectangle rect(Widget widget, int32_t index = 0) const;
+
+    /**
+     * @brief Élément le plus haut sous un point
+     * @param point Position à l'écran
+     * @return Élément touché, `Widget::NONE` si aucun
+     */
+    [[nodiscard]] Hit hitTest(Vector2 point) const;
+
+    /**
+     * @brief Met à jour l'élément survolé
+     * @param mouse Position du pointeur
+     */
+    void setPointer(Vector2 mouse) { this->hover_ = this->hitTest(mouse); }
+
+    /**
+     * @brief Élément survolé lors du dernier `setPointer`
+     */
+    [[nodiscard]] Hit hover() const noexcept { return this->hover_; }
+
+    /**
+     * @brief Indique si un élément est survolé
+     * @param widget Type d'élément
+     * @param index Rang pour les éléments indexés
+     * @return `true` si le pointeur est sur cet élément
+     */
+    [[nodiscard]] bool hovered(Widget widget, int32_t index = 0) const {
+        return this->hover_ == Hit{widget, index};
+    }
+};
+
+#endif // CODE_UI_INCLUDE_LAYOUT_HPP_
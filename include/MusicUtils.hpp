@@ -2,11 +2,18 @@
 #define CODE_UI_INCLUDE_MUSICUTILS_HPP_
 
 #include "Types.hpp"
+#include <array>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace MusicUtils {
 
+/// Orthographe des 12 classes de hauteur (do=0) dans une gamme donnée
+using ScaleSpelling = std::array<std::string_view, 12>;
+
 /**
  * @brief Sépare une chaîne de notes séparées par des espaces en vecteur
  */
@@ -24,6 +31,17 @@ namespace MusicUtils {
 [[nodiscard]] std::string noteDisplayLabel(const std::string& note,
                                            NotationMode mode);
 
+/**
+ * @brief Formate l'affichage d'une note, dans une ressource donnée
+ * @param note Note textuelle
+ * @param mode Mode de notation
+ * @param resource Ressource de la chaîne (arène d'image)
+ * @return Libellé de la note
+ */
+[[nodiscard]] std::pmr::string
+noteDisplayLabel(std::string_view note, NotationMode mode,
+                 std::pmr::memory_resource* resource);
+
 /**
  * @brief Formate l'affichage du nom d'un accord
  */
@@ -41,6 +59,17 @@ namespace MusicUtils {
 [[nodiscard]] std::vector<std::string> getScaleNotesList(ScaleChoice scale,
                                                          ModeChoice mode);
 
+/**
+ * @brief Renvoie la liste des notes d'une gamme, dans une ressource donnée
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @param resource Ressource de la liste et des notes (arène d'image)
+ * @return Notes de la gamme
+ */
+[[nodiscard]] std::pmr::vector<std::pmr::string>
+getScaleNotesList(ScaleChoice scale, ModeChoice mode,
+                  std::pmr::memory_resource* resource);
+
 /**
  * @brief Formate le nom complet d'une gamme
  */
@@ -48,6 +77,65 @@ namespace MusicUtils {
                                                 ModeChoice mode,
                                                 NotationMode notation);
 
+/**
+ * @brief Calcule la classe de hauteur d'une note, altérations multiples
+ * comprises (ex: "e#", "cbb", "fx4")
+ * @param note Note textuelle, octave facultative
+ * @return Classe de hauteur de 0 (do) à 11 (si), ou -1 si note invalide
+ */
+[[nodiscard]] int32_t pitchClass(std::string_view note);
+
+/**
+ * @brief Calcule le numéro MIDI d'une note (octave 4 si absente)
+ * @param note Note textuelle, octave facultative
+ * @return Numéro MIDI (c4 = 60), ou -1 si note invalide
+ */
+[[nodiscard]] int32_t midiNumber(std::string_view note);
+
+/**
+ * @brief Renvoie l'orthographe précalculée des 12 classes de hauteur d'une
+ * gamme (notes de la gamme, sensible du mineur, puis dièses ou bémols selon
+ * l'armure)
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @return Table indexée par classe de hauteur
+ */
+[[nodiscard]] const ScaleSpelling& getScaleSpelling(ScaleChoice scale,
+                                                    ModeChoice mode);
+
+/**
+ * @brief Orthographie une note selon la gamme, en conservant sa hauteur (ex:
+ * "d#4" → "eb4" en do mineur, "b#3" → "c4")
+ * @param note Note textuelle, octave facultative
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @return Note orthographiée, ou note inchangée si invalide
+ */
+[[nodiscard]] std::string spellNote(std::string_view note, ScaleChoice scale,
+                                    ModeChoice mode);
+
+/**
+ * @brief Nomme une touche selon la gamme (ex: 63 → "eb4" en do mineur,
+ * "d#4" en mi majeur)
+ * @param midi Numéro MIDI
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @return Note avec octave, vide hors des octaves 0 à 9
+ */
+[[nodiscard]] std::string noteName(int32_t midi, ScaleChoice scale,
+                                   ModeChoice mode);
+
+/**
+ * @brief Orthographie une liste de notes selon la gamme
+ * @param notes Notes textuelles
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @return Notes orthographiées, dans le même ordre
+ */
+[[nodiscard]] std::vector<std::string>
+spellNotes(const std::vector<std::string>& notes, ScaleChoice scale,
+           ModeChoice mode);
+
 /**
  * @brief Résout une note textuelle en index de touche de piano (blanche ou
  * noire)
@@ -63,14 +151,15 @@ getChallengeBaseOctave(const std::vector<std::string>& expectedNotes);
 
 /**
  * @brief Indique si deux représentations de notes font référence à la même
- * classe de note (sans octave)
+ * classe de note (sans octave) ; sans allocation
  */
-[[nodiscard]] bool isSameNoteClass(const std::string& a, const std::string& b);
+[[nodiscard]] bool isSameNoteClass(std::string_view a, std::string_view b);
 
 /**
- * @brief Vérifie si une note fait partie d'une liste
+ * @brief Vérifie si une note fait partie d'une liste, octave ignorée ; sans
+ * allocation
  */
-[[nodiscard]] bool noteInList(const std::string& noteBase,
+[[nodiscard]] bool noteInList(std::string_view noteBase,
                               const std::vector<std::string>& list);
 
 } // namespace MusicUtils
@@ -0,0 +1,76 @@
+#ifndef CODE_UI_INCLUDE_PIANOKEYMAP_HPP_
+#define CODE_UI_INCLUDE_PIANOKEYMAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// Disposition du clavier de l'ordinateur, pour les lettres affichées
+enum class KeyLayout : uint8_t {
+    NONE,   ///< Clavier de l'ordinateur ignoré
+    QWERTY,
+    AZERTY
+};
+
+/**
+ * @brief Correspondance entre le clavier de l'ordinateur et le piano, à la
+ * manière des séquenceurs : rangée du bas de do à mi de l'octave suivante,
+ * rangée des lettres du haut une octave plus haut, noires sur les rangées du
+ * dessus
+ *
+ * Les touches sont repérées par leur position (codes raylib, nommés d'après
+ * le QWERTY) : les mêmes rangées jouent sur tous les claviers. La
+ * disposition choisit seulement les lettres affichées sur les touches du
+ * piano.
+ */
+class PianoKeymap {
+  public:
+    static constexpr size_t SLOTS{34};   ///< Touches jouables
+    static constexpr int32_t SPAN{29};   ///< Demi-tons couverts depuis le do
+    static constexpr int32_t CODES{128}; ///< Codes de touche examinés
+
+  private:
+    KeyLayout layout_{KeyLayout::AZERTY};
+
+  public:
+    /**
+     * @brief Lit un nom de disposition
+     * @param name "qwerty", "azerty" ou "none"
+     * @param layout Disposition lue
+     * @return `false` si le nom est inconnu
+     */
+    static bool parse(std::string_view name, KeyLayout& layout);
+
+    void setLayout(KeyLayout layout) noexcept { this->layout_ = layout; }
+
+    [[nodiscard]] KeyLayout layout() const noexcept { return this->layout_; }
+
+    [[nodiscard]] bool enabled() const noexcept {
+        return this->layout_ != KeyLayout::NONE;
+    }
+
+    /**
+     * @brief Emplacement d'une touche de l'ordinateur
+     * @param key Code raylib de la touche
+     * @return Emplacement dans [0, SLOTS[, -1 si la touche ne joue pas ou si
+     * le clavier est ignoré
+     */
+    [[nodiscard]] int32_t slotOf(int32_t key) const noexcept;
+
+    /**
+     * @brief Hauteur jouée par un emplacement
+     * @param slot Emplacement dans [0, SLOTS[
+     * @return Demi-tons au-dessus du do de départ, dans [0, SPAN[
+     */
+    [[nodiscard]] static int32_t offset(int32_t slot) noexcept;
+
+    /**
+     * @brief Lettre gravée sur la touche d'un emplacement, selon la
+     * disposition
+     * @param slot Emplacement dans [0, SLOTS[
+     * @return Caractère ASCII, 0 si le clavier est ignoré
+     */
+    [[nodiscard]] char label(int32_t slot) const noexcept;
+};
+
+#endif // CODE_UI_INCLUDE_PIANOKEYMAP_HPP_
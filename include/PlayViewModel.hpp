@@ -0,0 +1,128 @@
+#ifndef CODE_UI_INCLUDE_PLAYVIEWMODEL_HPP_
+#define CODE_UI_INCLUDE_PLAYVIEWMODEL_HPP_
+
+#include "Types.hpp"
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Données préparées de l'écran de jeu (défi, gamme active, score),
+ * reconstruites seulement quand un message, un réglage ou la saisie change
+ * leurs entrées
+ */
+class PlayViewModel {
+  public:
+    static constexpr size_t MAX_BOXES{7}; ///< Notes de la gamme active
+
+  private:
+    // Entrées
+    float screenW_{0.0f};
+    float screenH_{0.0f};
+    ScaleChoice scale_{ScaleChoice::SCALE_C};
+    ModeChoice mode_{ModeChoice::MODE_MAJ};
+    NotationMode notation_{NotationMode::SYLLABIC};
+    Color userColor_{WHITE};
+    std::string challengeText_{"Attente…"};
+    std::vector<std::string> staffNotes_;
+    uint16_t expectedMask_{0}; ///< Bit n : classe de hauteur n attendue
+    uint16_t correctMask_{0};
+    uint16_t wrongMask_{0};
+    uint16_t pressedMask_{0};
+    int32_t hoverBox_{-1};
+    int32_t score_{-1};
+    const char* feedback_{""};
+
+    // Les positions de texte (sauf le score) sont le milieu du bord haut,
+    // centrées au rendu selon la largeur mesurée par le cache de textes
+
+    // Zone de défi
+    Rectangle challengeRect_{};
+    bool showStaff_{false};
+    Vector2 challengeTextPos_{};
+    int32_t challengeTextSize_{36};
+
+    // Gamme active
+    std::string scaleTitle_;
+    Vector2 scaleTitlePos_{};
+    size_t boxCount_{0};
+    std::array<int32_t, MAX_BOXES> boxPitch_{};
+    std::array<Rectangle, MAX_BOXES> boxRect_{};
+    std::array<std::string, MAX_BOXES> boxLabel_{};
+    std::array<int32_t, MAX_BOXES> boxFontSize_{};
+    std::array<Vector2, MAX_BOXES> boxLabelPos_{};
+    std::array<Color, MAX_BOXES> boxFill_{};
+    std::array<Color, MAX_BOXES> boxBorder_{};
+    std::array<Color, MAX_BOXES> boxText_{};
+    std::array<float, MAX_BOXES> boxLineWidth_{};
+
+    // Score et message d'encouragement
+    std::string scoreText_;
+    Vector2 scorePos_{};
+    Vector2 feedbackPos_{};
+
+    /**
+     * @brief Recalcule géométrie et libellés
+     */
+    void layout();
+
+    /**
+     * @brief Recalcule les couleurs des cases de la gamme
+     */
+    void recolor();
+
+  public:
+    /**
+     * @brief Adapte la géométrie, sans effet si la taille est inchangée
+     * @param screenW Largeur de la fenêtre
+     * @param screenH Hauteur de la fenêtre
+     */
+    void setLayout(float screenW, float screenH);
+
+    /**
+     * @brief Applique les réglages de la partie
+     * @param scale Gamme
+     * @param mode Mode
+     * @param notation Notation des libellés
+     * @param userColor Couleur du profil actif
+     */
+    void setSettings(ScaleChoice scale, ModeChoice mode, NotationMode notation,
+                     Color userColor);
+
+    /**
+     * @brief Affiche un nouveau défi
+     * @param challenge Défi reçu, ou défi vide pour l'attente
+     */
+    void setChallenge(const Challenge& challenge);
+
+    /**
+     * @brief Affiche le résultat du dernier défi
+     * @param result Résultat, effacé si inactif
+     */
+    void setResult(const ChallengeResult& result);
+
+    /**
+     * @brief Met à jour score et message d'encouragement
+     * @param score Score courant
+     * @param feedback Message affiché (chaîne statique)
+     */
+    void setScore(int32_t score, const char* feedback);
+
+    [[nodiscard]] Rectangle challengeRect() const noexcept {
+        return this->challengeRect_;
+    }
+
+    /**
+     * @brief Met à jour survol et touches enfoncées, sans effet si inchangés
+     * @param mouse Position du pointeur
+     * @param pressedPitchClasses Classes de hauteur enfoncées au clavier
+     */
+    void setPointer(Vector2 mouse, uint16_t pressedPitchClasses);
+
+    // Le rendu lit directement les données préparées
+    friend class UI;
+};
+
+#endif // CODE_UI_INCLUDE_PLAYVIEWMODEL_HPP_
@@ -0,0 +1,165 @@
+#ifndef CODE_UI_INCLUDE_PROFILER_HPP_
+#define CODE_UI_INCLUDE_PROFILER_HPP_
+
+#include "AllocCounter.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/// Étapes d'une image mesurées par le profileur
+enum class FrameSection : uint8_t {
+    MESSAGES, ///< `processIncomingMessages`
+    LOGIC,    ///< `updateLogic` et mises en page
+    DRAW,     ///< `UI::record`, sur son thread pendant `PRESENT` s'il y en a un
+    PRESENT,  ///< Soumission de la liste, `EndDrawing`, échange des tampons
+    COUNT
+};
+
+/// Mesures d'une image
+struct FrameSample {
+    float totalMs{0.0f};
+    std::array<float, static_cast<size_t>(FrameSection::COUNT)> sectionMs{};
+    uint32_t allocations{0}; ///< Allocations du thread principal
+    /// Allocations de chaque étape, comptées sur le thread qui l'exécute
+    std::array<uint32_t, static_cast<size_t>(FrameSection::COUNT)>
+        sectionAllocs{};
+};
+
+/// Synthèse de l'historique, recalculée seulement quand le HUD est affiché
+struct FrameStats {
+    float p50Ms{0.0f};
+    float p95Ms{0.0f};
+    float p99Ms{0.0f};
+    float maxMs{0.0f};
+    FrameSample mean{};       ///< Moyenne par étape et allocations par image
+    float latencyMs{0.0f};    ///< Dernière latence clavier → image
+    float latencyMaxMs{0.0f}; ///< Pire latence de l'historique
+};
+
+/**
+ * @brief Profileur d'images : durée de chaque étape de la boucle principale,
+ * historique glissant pour le graphe et les percentiles, profondeur et débit
+ * de la file de messages, allocations par image et par étape, latence entre
+ * un appui au clavier et l'image qui l'affiche
+ */
+class FrameProfiler {
+  public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t HISTORY{240};        ///< Images conservées
+    static constexpr size_t LATENCY_HISTORY{32}; ///< Appuis conservés
+
+    /// Mesure d'une étape, ajoutée à l'image courante à la destruction
+    class Scope {
+      private:
+        FrameProfiler& profiler_;
+        FrameSection section_;
+        Clock::time_point start_;
+        uint64_t allocStart_; ///< Compteur du thread de l'étape
+
+      public:
+        Scope(FrameProfiler& profiler, FrameSection section)
+            : profiler_(profiler), section_(section), start_(Clock::now()),
+              allocStart_(AllocCounter::threadCount()) {}
+        ~Scope() {
+            this->profiler_.add(this->section_, this->start_,
+                                AllocCounter::threadCount() -
+                                    this->allocStart_);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+  private:
+    std::array<FrameSample, HISTORY> history_{};
+    size_t next_{0};  ///< Prochaine case à écrire
+    size_t count_{0}; ///< Images présentes
+    FrameSample current_{};
+    FrameStats stats_{};
+    Clock::time_point frameStart_{};
+    uint64_t allocStart_{0};
+    uint64_t frames_{0}; ///< Images closes depuis le démarrage
+
+    size_t queueDepth_{0};         ///< Messages en attente en début d'image
+    uint32_t messages_{0};         ///< Messages traités depuis `rateStart_`
+    uint32_t messagesPerSecond_{0};
+    Clock::time_point rateStart_{};
+
+    std::array<float, LATENCY_HISTORY> latencyMs_{};
+    size_t latencyNext_{0};
+    size_t latencyCount_{0};
+
+    bool visible_{false};
+
+    /**
+     * @brief Ajoute la durée et les allocations d'une étape à l'image courante
+     * @param section Étape
+     * @param start Début de l'étape
+     * @param allocations Allocations pendant l'étape
+     */
+    void add(FrameSection section, Clock::time_point start,
+             uint64_t allocations);
+
+    /**
+     * @brief Recalcule percentiles et moyennes de l'historique
+     */
+    void summarize();
+
+  public:
+    /**
+     * @brief Démarre la mesure d'une image
+     */
+    void beginFrame();
+
+    /**
+     * @brief Mesure une étape jusqu'à la fin de la portée
+     * @param section Étape
+     * @return Mesure en cours
+     */
+    [[nodiscard]] Scope measure(FrameSection section) {
+        return {*this, section};
+    }
+
+    /**
+     * @brief Clôt l'image courante et l'ajoute à l'historique ; à n'appeler
+     * que pour les images dessinées. En mode audit, journalise les images qui
+     * ont alloué
+     */
+    void endFrame();
+
+    /**
+     * @brief Compte les messages dépilés dans l'image
+     * @param processed Messages traités
+     * @param queueDepth Messages en file avant traitement
+     */
+    void countMessages(size_t processed, size_t queueDepth);
+
+    /**
+     * @brief Enregistre la latence d'un appui : de l'événement de touche à la
+     * présentation de l'image qui montre la touche enfoncée
+     * @param seconds Durée, sur l'horloge des entrées
+     */
+    void addInputLatency(double seconds);
+
+    /**
+     * @brief Dernière latence enregistrée
+     * @return Millisecondes, 0 avant le premier appui
+     */
+    [[nodiscard]] float lastInputLatencyMs() const noexcept {
+        if (this->latencyCount_ == 0) return 0.0f;
+        return this->latencyMs_[(this->latencyNext_ + LATENCY_HISTORY - 1) %
+                                LATENCY_HISTORY];
+    }
+
+    /**
+     * @brief Affiche ou masque le HUD
+     */
+    void toggle() noexcept { this->visible_ = !this->visible_; }
+
+    [[nodiscard]] bool visible() const noexcept { return this->visible_; }
+
+    // Le rendu lit directement l'historique
+    friend class UI;
+};
+
+#endif // CODE_UI_INCLUDE_PROFILER_HPP_
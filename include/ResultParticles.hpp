@@ -0,0 +1,103 @@
+#ifndef CODE_UI_INCLUDE_RESULTPARTICLES_HPP_
+#define CODE_UI_INCLUDE_RESULTPARTICLES_HPP_
+
+#include "raylib.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Effets du résultat d'un défi : gerbes de particules jaillissant des
+ * touches jouées et points gagnés qui s'envolent
+ *
+ * Chaque particule part du bord haut de sa touche avec une vitesse tirée au
+ * hasard, retombe sous la gravité et pâlit à son propre rythme ; elle
+ * disparaît une fois transparente. Positions et vitesses sont en pixels de
+ * l'écran. Les réserves sont fixes : une gerbe trop grosse est tronquée,
+ * jamais agrandie. Le tirage est un xorshift à graine fixe : un rejeu produit
+ * les mêmes gerbes.
+ */
+class ResultParticles {
+  public:
+    static constexpr size_t CAPACITY{4096};    ///< Particules à l'écran au plus
+    static constexpr size_t POPUP_CAPACITY{8}; ///< Points affichés à la fois
+    static constexpr float GRAVITY{900.0f};    ///< Pixels par seconde carrée
+    static constexpr float LIFETIME{1.2f};     ///< Durée de vie la plus longue
+    static constexpr float POPUP_TIME{1.0f};   ///< Durée d'affichage des points
+    static constexpr float POPUP_RISE{80.0f};  ///< Montée des points, pixels/s
+
+  private:
+    std::array<float, CAPACITY> x_{};
+    std::array<float, CAPACITY> y_{};
+    std::array<float, CAPACITY> vx_{};
+    std::array<float, CAPACITY> vy_{};
+    std::array<float, CAPACITY> life_{};  ///< Opacité restante
+    std::array<float, CAPACITY> decay_{}; ///< Perte d'opacité par seconde
+    std::array<float, CAPACITY> size_{};  ///< Côté du carré, en pixels
+    std::array<Color, CAPACITY> color_{};
+    size_t count_{0};
+    uint32_t dropped_{0}; ///< Particules refusées, réserve pleine
+    uint32_t seed_{0x9E3779B9U};
+
+    std::array<Vector2, POPUP_CAPACITY> popupPos_{};
+    std::array<float, POPUP_CAPACITY> popupLife_{};
+    std::array<const char*, POPUP_CAPACITY> popupText_{};
+    std::array<Color, POPUP_CAPACITY> popupColor_{};
+    size_t popupCount_{0};
+
+    /**
+     * @brief Tirage pseudo-aléatoire uniforme
+     * @return Valeur dans [0, 1[
+     */
+    float random() noexcept;
+
+  public:
+    /**
+     * @brief Fait jaillir une gerbe du bord haut d'un rectangle
+     * @param from Rectangle d'origine (touche, zone de défi)
+     * @param color Couleur des particules
+     * @param count Particules demandées ; l'excédent sur la réserve est
+     * compté dans `dropped()`
+     */
+    void burst(Rectangle from, Color color, size_t count);
+
+    /**
+     * @brief Affiche des points qui montent puis s'effacent ; remplace le
+     * plus ancien si tous sont pris
+     * @param at Centre du texte
+     * @param text Texte statique, par exemple "+10"
+     * @param color Couleur
+     */
+    void popup(Vector2 at, const char* text, Color color);
+
+    /**
+     * @brief Retire particules et points
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Avance les particules et les points, retire ceux éteints
+     * @param dt Temps écoulé depuis l'image précédente, en secondes
+     * @return `true` si quelque chose était à l'écran avant l'appel : l'image
+     * doit être redessinée, ne serait-ce que pour effacer les derniers
+     */
+    bool animate(float dt);
+
+    /**
+     * @brief Carré dessiné pour une particule
+     * @param i Rang dans `[0, count()[`
+     * @return Carré centré sur la particule, en pixels
+     */
+    [[nodiscard]] Rectangle rect(size_t i) const noexcept;
+
+    [[nodiscard]] size_t count() const noexcept { return this->count_; }
+
+    [[nodiscard]] size_t popups() const noexcept { return this->popupCount_; }
+
+    [[nodiscard]] uint32_t dropped() const noexcept { return this->dropped_; }
+
+    // UI::drawEffects émet un quad par particule depuis les tableaux
+    friend class UI;
+};
+
+#endif // CODE_UI_INCLUDE_RESULTPARTICLES_HPP_
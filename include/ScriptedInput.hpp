@@ -0,0 +1,207 @@
+#ifndef CODE_UI_INCLUDE_SCRIPTEDINPUT_HPP_
+#define CODE_UI_INCLUDE_SCRIPTEDINPUT_HPP_
+
+#include "Communication.hpp"
+#include "InputProvider.hpp"
+#include "Message.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Scénario rejoué : entrées et messages du moteur datés sur une
+ * horloge virtuelle, qui saute directement à l'événement suivant quand la
+ * boucle attend ; la logique tourne ainsi sans fenêtre ni moteur, bien plus
+ * vite que le temps réel et toujours de la même façon
+ */
+class ScriptedInput : public InputProvider {
+  public:
+    static constexpr double FRAME_PERIOD{1.0 / 60.0}; ///< Image dessinée
+
+  private:
+    /// Événement d'entrée daté
+    struct Event {
+        enum class Kind : uint8_t {
+            RESIZE,
+            MOVE,
+            BUTTON,
+            WHEEL,
+            KEY,
+            KEY_CODE,
+            TEXT,
+            DROP
+        };
+
+        double time{0.0};
+        Kind kind{Kind::MOVE};
+        Vector2 value{};  ///< Position, taille d'écran ou crans (`x`)
+        bool down{false}; ///< Bouton ou touche enfoncé
+        InputKey key{InputKey::COUNT};
+        int32_t code{0}; ///< Code raylib d'une touche du clavier
+        std::string text;
+    };
+
+    /// Message du moteur daté
+    struct Incoming {
+        double time{0.0};
+        Message message;
+    };
+
+    std::vector<Event> events_; ///< Triés par date à la première lecture
+    std::vector<Incoming> incoming_;
+    size_t nextEvent_{0};
+    size_t nextIncoming_{0};
+    bool sorted_{false};
+    double end_{0.0}; ///< Fermeture de la fenêtre simulée
+
+    // État rejoué
+    double clock_{0.0};
+    Vector2 screen_{1280.0f, 800.0f};
+    Vector2 mouse_{-1.0f, -1.0f};
+    bool buttonDown_{false};
+
+    Communication* link_{nullptr}; ///< Lien simulé branché
+    std::vector<Message> sent_;    ///< Envoyés par l'application
+
+    /**
+     * @brief Ajoute un événement d'entrée
+     * @param time Date
+     * @param kind Nature de l'événement
+     * @return Événement ajouté, à compléter
+     */
+    Event& add(double time, Event::Kind kind);
+
+    /**
+     * @brief Trie les événements par date, une seule fois
+     */
+    void sort();
+
+    /**
+     * @brief Date du prochain événement ou message
+     * @return Secondes, `end_` s'il n'y en a plus
+     */
+    [[nodiscard]] double nextTime() const;
+
+  public:
+    /**
+     * @brief Change la taille de l'écran
+     * @param time Date
+     * @param w Largeur
+     * @param h Hauteur
+     */
+    ScriptedInput& resize(double time, float w, float h);
+
+    /**
+     * @brief Déplace le pointeur
+     * @param time Date
+     * @param position Position à l'écran
+     */
+    ScriptedInput& move(double time, Vector2 position);
+
+    /**
+     * @brief Enfonce ou relâche le bouton principal
+     * @param time Date
+     * @param down `true` pour enfoncer
+     */
+    ScriptedInput& button(double time, bool down);
+
+    /**
+     * @brief Clic complet : déplacement, appui, relâchement une image après
+     * @param time Date de l'appui
+     * @param position Position à l'écran
+     */
+    ScriptedInput& click(double time, Vector2 position);
+
+    /**
+     * @brief Tourne la molette
+     * @param time Date
+     * @param steps Crans, positifs vers l'avant
+     */
+    ScriptedInput& wheel(double time, float steps);
+
+    /**
+     * @brief Enfonce une touche pendant une image
+     * @param time Date
+     * @param key Touche
+     */
+    ScriptedInput& press(double time, InputKey key);
+
+    /**
+     * @brief Enfonce une touche du clavier, jusqu'à `keyUp`
+     * @param time Date, transmise telle quelle à l'application
+     * @param key Code raylib de la touche (`KEY_Z`…)
+     */
+    ScriptedInput& keyDown(double time, int32_t key);
+
+    /**
+     * @brief Relâche une touche du clavier
+     * @param time Date, transmise telle quelle à l'application
+     * @param key Code raylib de la touche
+     */
+    ScriptedInput& keyUp(double time, int32_t key);
+
+    /**
+     * @brief Saisit du texte en une image
+     * @param time Date
+     * @param text Caractères ASCII
+     */
+    ScriptedInput& type(double time, std::string_view text);
+
+    /**
+     * @brief Fait recevoir un message du moteur
+     * @param time Date de réception
+     * @param message Message reçu
+     */
+    ScriptedInput& receive(double time, Message message);
+
+    /**
+     * @brief Coupe le lien, comme un moteur qui s'arrête ; l'application le
+     * rétablit à sa prochaine tentative de reconnexion
+     * @param time Date de la coupure
+     */
+    ScriptedInput& dropLink(double time);
+
+    /**
+     * @brief Date la fermeture de la fenêtre simulée, fin du rejeu
+     * @param time Date ; au plus tôt après le dernier événement
+     */
+    ScriptedInput& quitAt(double time);
+
+    /**
+     * @brief Branche le scénario sur un lien : messages reçus injectés dans
+     * sa file à leur date, envois enregistrés au lieu d'être écrits
+     * @param comm Lien de l'application rejouée
+     */
+    void attach(Communication& comm);
+
+    /**
+     * @brief Débranche le lien
+     */
+    void detach();
+
+    void poll(InputFrame& frame) override;
+
+    /**
+     * @brief Avance l'horloge jusqu'au prochain événement, au plus de
+     * `seconds`
+     */
+    void wait(double seconds) override;
+
+    /**
+     * @brief Avance l'horloge d'une image (cadence de 60 images/s)
+     */
+    void present() override { this->clock_ += FRAME_PERIOD; }
+
+    [[nodiscard]] double now() const override { return this->clock_; }
+
+    /**
+     * @brief Messages envoyés au moteur par l'application, dans l'ordre
+     * @return Messages enregistrés depuis `attach`
+     */
+    [[nodiscard]] const std::vector<Message>& sent() const noexcept {
+        return this->sent_;
+    }
+};
+
+#endif // CODE_UI_INCLUDE_SCRIPTEDINPUT_HPP_
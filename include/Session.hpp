@@ -0,0 +1,167 @@
+#ifndef CODE_UI_INCLUDE_SESSION_HPP_
+#define CODE_UI_INCLUDE_SESSION_HPP_
+
+#include "Message.hpp"
+#include <algorithm>
+#include <coroutine>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Coroutine de session (config → ack → défis → over), suspendue à
+ * chaque attente d'un message du moteur
+ */
+class SessionTask {
+  public:
+    struct promise_type {
+        SessionTask get_return_object() {
+            return SessionTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        /// Démarrage différé : `SessionDriver::start` reprend la coroutine
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { throw; }
+    };
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit SessionTask(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+  public:
+    SessionTask() = default;
+    ~SessionTask() {
+        if (this->handle_) this->handle_.destroy();
+    }
+
+    SessionTask(const SessionTask&) = delete;
+    SessionTask& operator=(const SessionTask&) = delete;
+    SessionTask(SessionTask&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})) {}
+    SessionTask& operator=(SessionTask&& other) noexcept {
+        if (this != &other) {
+            if (this->handle_) this->handle_.destroy();
+            this->handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Indique si une coroutine est encore en cours
+     * @return `true` si la coroutine existe et n'est pas terminée
+     */
+    [[nodiscard]] bool running() const noexcept {
+        return this->handle_ && !this->handle_.done();
+    }
+
+    /**
+     * @brief Reprend la coroutine jusqu'à sa prochaine suspension
+     */
+    void resume() const { this->handle_.resume(); }
+};
+
+/**
+ * @brief Ordonnanceur de la coroutine de session : reprise par les messages
+ * reçus (`deliver`) et par le tic d'image (`tick`) pour les délais
+ */
+class SessionDriver {
+  private:
+    SessionTask task_;                      ///< Coroutine en cours
+    std::coroutine_handle<> waiter_;        ///< Point de suspension courant
+    std::vector<std::string_view> awaited_; ///< Types de message attendus
+    std::optional<Message> received_;      ///< Message remis à la reprise
+    float remaining_{0.0f}; ///< Secondes avant expiration, <= 0 sans limite
+
+    /**
+     * @brief Reprend la coroutine suspendue et libère son cadre si elle a fini
+     * @param msg Message remis, vide en cas d'expiration
+     */
+    void wake(std::optional<Message> msg);
+
+  public:
+    /// Attente d'un message parmi les types enregistrés par `receive`
+    struct MessageAwaiter {
+        SessionDriver& driver;
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            this->driver.waiter_ = handle;
+        }
+        std::optional<Message> await_resume() {
+            return std::exchange(this->driver.received_, std::nullopt);
+        }
+    };
+
+    SessionDriver() = default;
+    SessionDriver(const SessionDriver&) = delete;
+    SessionDriver& operator=(const SessionDriver&) = delete;
+
+    static constexpr float NO_TIMEOUT{0.0f}; ///< Attente sans limite
+
+    /**
+     * @brief Attend le prochain message d'un des types donnés
+     * @param timeout Délai en secondes, `NO_TIMEOUT` pour attendre sans limite
+     * @param types Types acceptés ; un message d'un autre type n'est pas remis
+     * @return Awaitable renvoyant le message, ou `std::nullopt` à expiration
+     * (ou si `skip` est appelé)
+     */
+    template <typename... Types>
+    [[nodiscard]] MessageAwaiter receive(float timeout, Types... types) {
+        this->awaited_ = {std::string_view(types)...};
+        this->remaining_ = timeout;
+        return {*this};
+    }
+
+    /**
+     * @brief Lance une coroutine de session, en annulant la précédente
+     * @param task Coroutine créée par l'appelant, pas encore démarrée
+     */
+    void start(SessionTask task);
+
+    /**
+     * @brief Remet un message à la coroutine si elle attend ce type
+     * @param msg Message reçu du moteur
+     * @return `true` si le message a été consommé par la session
+     */
+    bool deliver(const Message& msg);
+
+    /**
+     * @brief Avance le délai de l'attente en cours, et reprend la coroutine
+     * avec `std::nullopt` à expiration
+     * @param dt Temps écoulé depuis le tic précédent, en secondes
+     * @return `true` si l'attente a expiré et la coroutine a été reprise
+     */
+    bool tick(float dt);
+
+    /**
+     * @brief Temps restant avant expiration de l'attente en cours
+     * @return Secondes restantes, 0 sans attente limitée
+     */
+    [[nodiscard]] float timeLeft() const noexcept {
+        return this->waiter_ ? std::max(this->remaining_, 0.0f) : 0.0f;
+    }
+
+    /**
+     * @brief Termine immédiatement l'attente en cours, comme une expiration
+     */
+    void skip();
+
+    /**
+     * @brief Détruit la coroutine suspendue (ses variables locales sont
+     * libérées), sans la reprendre
+     */
+    void cancel();
+
+    /**
+     * @brief Indique si une session est en cours
+     * @return `true` tant que la coroutine n'est pas terminée ou annulée
+     */
+    [[nodiscard]] bool active() const noexcept { return this->task_.running(); }
+};
+
+#endif // CODE_UI_INCLUDE_SESSION_HPP_
@@ -0,0 +1,29 @@
+#ifndef CODE_UI_INCLUDE_SWAPREMOVE_HPP_
+#define CODE_UI_INCLUDE_SWAPREMOVE_HPP_
+
+#include <cstddef>
+
+/**
+ * @brief Retire d'une réserve en tableaux parallèles les éléments à jeter,
+ * chacun remplacé par le dernier : les éléments gardés restent dans
+ * `[0, count[`, sans ordre, et rien n'est alloué
+ * @param count Éléments actifs, dans `[0, count[` de chaque tableau
+ * @param keep Prédicat `bool(size_t i)` lisant les tableaux au rang `i` ;
+ * réévalué au même rang après chaque remplacement
+ * @param arrays Tableaux parallèles indexables, tous déplacés ensemble
+ * @return Nombre d'éléments gardés
+ */
+template <typename Keep, typename... Arrays>
+size_t swapRemove(size_t count, Keep&& keep, Arrays&... arrays) {
+    for (size_t i = 0; i < count;) {
+        if (keep(i)) {
+            ++i;
+            continue;
+        }
+        --count;
+        ((arrays[i] = arrays[count]), ...);
+    }
+    return count;
+}
+
+#endif // CODE_UI_INCLUDE_SWAPREMOVE_HPP_
@@ -0,0 +1,130 @@
+#ifndef CODE_UI_INCLUDE_TEXTCACHE_HPP_
+#define CODE_UI_INCLUDE_TEXTCACHE_HPP_
+
+#include "LayerCache.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Quad d'un glyphe : coordonnées de texture et position relative au texte
+struct GlyphQuad {
+    float u0, v0, u1, v1; ///< Coordonnées normalisées dans l'atlas
+    Rectangle dest;       ///< Position relative au coin haut gauche du texte
+};
+
+/// Texte préparé : glyphes positionnés et largeur mesurée une fois pour toutes
+struct TextRun {
+    const Font* font{nullptr};
+    std::vector<GlyphQuad> quads;
+    float width{0.0f};
+};
+
+/**
+ * @brief Cache de textes préparés par chaîne et taille, adossé à des atlas de
+ * police générés au démarrage pour les tailles de l'interface ; un texte
+ * inchangé coûte un seul lot de quads, sans formatage ni mesure
+ *
+ * Les textes sont dessinés par `DrawList::text`. Sans appel OpenGL après
+ * `load`, le cache peut servir au thread d'enregistrement des images.
+ */
+class TextCache {
+  public:
+    /// Tailles rastérisées à l'avance ; les autres réduisent l'atlas supérieur
+    static constexpr std::array<int32_t, 8> ATLAS_SIZES{15, 18, 20, 22,
+                                                        25, 30, 40, 60};
+    static constexpr size_t MAX_RUNS{512}; ///< Au-delà, le cache est vidé
+    static constexpr size_t FORMAT_CAPACITY{128};
+
+  private:
+    /// Hachage transparent : recherche par `string_view` sans allocation
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const noexcept {
+            return std::hash<std::string_view>{}(text);
+        }
+    };
+    using RunMap =
+        std::unordered_map<std::string, TextRun, StringHash, std::equal_to<>>;
+
+    std::array<Font, ATLAS_SIZES.size()> fonts_{};
+    std::array<bool, ATLAS_SIZES.size()> owned_{}; ///< Chargée depuis un TTF
+    std::vector<std::pair<int32_t, RunMap>> runs_; ///< Par taille demandée
+    std::unordered_map<uint64_t, TextRun> formatted_; ///< Par empreinte
+    size_t count_{0};
+
+    /**
+     * @brief Choisit l'atlas le plus petit couvrant une taille
+     * @param size Taille demandée, en pixels
+     * @return Police de l'atlas, police par défaut si non chargée
+     */
+    [[nodiscard]] const Font& fontFor(int32_t size);
+
+    /**
+     * @brief Positionne les glyphes d'un texte
+     * @param text Texte UTF-8
+     * @param size Taille demandée, en pixels
+     * @return Texte préparé
+     */
+    [[nodiscard]] TextRun build(std::string_view text, int32_t size);
+
+    /**
+     * @brief Vide le cache s'il est plein, avant une insertion
+     */
+    void reserveSlot();
+
+  public:
+    /**
+     * @brief Génère les atlas ; à appeler après `InitWindow`
+     * @param path Police TTF/OTF, vide ou introuvable pour la police par
+     * défaut de raylib
+     */
+    void load(const std::string& path);
+
+    /**
+     * @brief Libère les atlas ; à appeler avant `CloseWindow`
+     */
+    void unload();
+
+    /**
+     * @brief Texte préparé, construit au premier appel
+     * @param text Texte UTF-8
+     * @param size Taille en pixels
+     * @return Référence valable jusqu'à la prochaine insertion
+     */
+    const TextRun& get(std::string_view text, int32_t size);
+
+    /**
+     * @brief Texte formaté préparé, retrouvé par empreinte du format et des
+     * arguments : le formatage n'a lieu qu'au premier appel
+     * @param size Taille en pixels
+     * @param fmt Format `std::format`
+     * @param args Arguments (scalaires ou chaînes)
+     * @return Référence valable jusqu'à la prochaine insertion
+     */
+    template <typename... Args>
+    const TextRun& format(int32_t size, std::format_string<Args...> fmt,
+                          Args&&... args) {
+        LayerKey key;
+        key.add(size).add(fmt.get());
+        (key.add(args), ...);
+        auto it = this->formatted_.find(key.value());
+        if (it != this->formatted_.end()) return it->second;
+
+        std::array<char, FORMAT_CAPACITY> buffer{};
+        auto result = std::format_to_n(buffer.data(), buffer.size(), fmt,
+                                       std::forward<Args>(args)...);
+        auto length = std::min(static_cast<size_t>(result.size), buffer.size());
+        TextRun run = this->build({buffer.data(), length}, size);
+        this->reserveSlot();
+        return this->formatted_.emplace(key.value(), std::move(run))
+            .first->second;
+    }
+};
+
+#endif // CODE_UI_INCLUDE_TEXTCACHE_HPP_
@@ -0,0 +1,34 @@
+#ifndef CODE_UI_INCLUDE_THREADTUNING_HPP_
+#define CODE_UI_INCLUDE_THREADTUNING_HPP_
+
+#include <cstdint>
+#include <string>
+
+/// Politique d'ordonnancement voulue pour un thread (affinité, priorité)
+struct ThreadPolicy {
+    int32_t cpu{-1};         ///< Cœur imposé, -1 pour laisser libre
+    int32_t fifoPriority{0}; ///< Priorité `SCHED_FIFO` (1-99), 0 pour CFS
+    int32_t nice{0};         ///< Niveau nice sous CFS (-20 à 19)
+
+    /**
+     * @brief Indique si la politique laisse l'ordonnancement par défaut
+     * @return `true` si aucun réglage n'est demandé
+     */
+    [[nodiscard]] bool isDefault() const noexcept {
+        return this->cpu < 0 && this->fifoPriority <= 0 && this->nice == 0;
+    }
+};
+
+namespace ThreadTuning {
+
+/**
+ * @brief Applique une politique au thread appelant, avec repli si les
+ * permissions manquent (`SCHED_FIFO` refusé → nice, nice refusé → CFS)
+ * @param policy Politique demandée
+ * @return Description de ce qui a été réellement appliqué, pour le log
+ */
+[[nodiscard]] std::string applyToCurrentThread(const ThreadPolicy& policy);
+
+} // namespace ThreadTuning
+
+#endif // CODE_UI_INCLUDE_THREADTUNING_HPP_
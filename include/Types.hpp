@@ -16,7 +16,7 @@ inline constexpr Color kOrangeNote = {255, 140, 0, 255};
 /// États de l'application
 enum class AppState { PROFILE_SELECT, MENU, PLAY, GAME_OVER };
 
-/// États du protocole (côté client)
+/// États du protocole (côté client), tenus par la coroutine de session
 enum class EngineState {
     ENG_DISCONNECTED,
     ENG_CONNECTED,
@@ -68,7 +68,6 @@ struct Challenge {
 struct ChallengeResult {
     std::vector<std::string> correct;
     std::vector<std::string> incorrect;
-    float displayTimer{0.0f}; ///< Minuterie d'affichage
     bool active{false};
 };
 
@@ -7,42 +7,79 @@
 
 // Forward declaration of AppController to avoid circular dependency
 class AppController;
+class DrawList;
+class KeyboardModel;
+class FallingNotes;
+class CachedLayer;
+class TextCache;
+class FrameProfiler;
+class ResultParticles;
 
 class UI {
   public:
     UI() = delete; ///< Static-only utility rendering class
 
     /**
-     * @brief Point d'entrée principal pour le rendu de l'interface
+     * @brief Point d'entrée principal : enregistre l'image de l'interface,
+     * sans appel OpenGL ; la liste est soumise ensuite par le thread de la
+     * fenêtre. L'arène de l'image est remise à zéro au début
+     * @param app Application, non modifiée pendant l'enregistrement
+     * @param out Liste vide à remplir
+     * @param screenW Largeur de l'écran
+     * @param screenH Hauteur de l'écran
      */
-    static void draw(AppController& app, Vector2 mouse, float screenW,
-                     float screenH);
+    static void record(AppController& app, DrawList& out, float screenW,
+                       float screenH);
 
   private:
     /**
-     * @brief Dessine un bouton avec effet de survol
-     * @return true si le bouton est survolé
+     * @brief Dessine un bouton, en surbrillance s'il est survolé
      */
-    [[nodiscard]] static bool drawButton(Rectangle rec, const char* text,
-                                         Color color, Vector2 mouse,
-                                         int32_t fontSize = 20);
+    static void drawButton(DrawList& out, TextCache& texts, Rectangle rec,
+                           const char* text, Color color, bool hover,
+                           int32_t fontSize = 20);
 
     /**
-     * @brief Dessine une portée de 5 lignes avec les notes indiquées
+     * @brief Dessine les lignes, barres de mesure et clé de sol d'une portée
      */
-    static void drawStaff(const AppController& app, Rectangle rec,
+    static void drawStaffBackground(DrawList& out, Rectangle rec, Color color,
+                                    Texture2D clef);
+
+    /**
+     * @brief Dessine une portée de 5 lignes avec les notes indiquées, déjà
+     * orthographiées selon la gamme ; le fond de portée est mis en cache
+     */
+    static void drawStaff(DrawList& out, CachedLayer& background,
+                          TextCache& texts, Texture2D clef, Rectangle rec,
                           const std::vector<std::string>& notes, Color color);
 
-    static void drawProfileSelect(AppController& app, Vector2 mouse,
+    static void drawProfileSelect(AppController& app, DrawList& out,
                                   float screenW, float screenH);
-    static void drawMenu(AppController& app, Vector2 mouse, float screenW,
+    static void drawMenu(AppController& app, DrawList& out, float screenW,
                          float screenH);
-    static void drawPlay(AppController& app, Vector2 mouse, float screenW,
+    static void drawMenuContent(AppController& app, DrawList& out,
+                                float screenW, float screenH);
+    static void drawPlay(AppController& app, DrawList& out, float screenW,
                          float screenH);
-    static void drawGameOver(AppController& app, Vector2 mouse, float screenW,
+    static void drawGameOver(AppController& app, DrawList& out, float screenW,
                              float screenH);
-    static void drawVirtualKeyboard(AppController& app, float screenW,
-                                    float screenH, Vector2 mouse);
+    static void drawVirtualKeyboard(DrawList& out,
+                                    const KeyboardModel& keyboard,
+                                    CachedLayer& outlines, TextCache& texts);
+    /**
+     * @brief Dessine les notes qui tombent en un seul lot, alignées sur la
+     * fenêtre visible du clavier
+     */
+    static void drawFallingNotes(DrawList& out, const FallingNotes& notes,
+                                 const KeyboardModel& keyboard);
+    /**
+     * @brief Dessine les particules du résultat en un seul lot, puis les
+     * points gagnés
+     */
+    static void drawEffects(DrawList& out, TextCache& texts,
+                            const ResultParticles& effects);
+    static void drawProfiler(DrawList& out, const FrameProfiler& profiler,
+                             float screenW);
 };
 
 #endif // CODE_UI_INCLUDE_UI_HPP_
@@ -0,0 +1,62 @@
+#include "AllocCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+/// Compteur propre à chaque thread : ni verrou ni atomique
+thread_local uint64_t allocations{0};
+} // namespace
+
+uint64_t AllocCounter::threadCount() noexcept { return allocations; }
+
+// Les variantes tableau et `nothrow` de la bibliothèque standard passent par
+// ces deux opérateurs ; les `delete` par défaut libèrent avec `free`. En mode
+// audit, l'appel est compté par `malloc` ou `aligned_alloc`
+void* operator new(std::size_t size) {
+    if constexpr (!AllocCounter::AUDIT) ++allocations;
+    if (size == 0) size = 1;
+    void* p = std::malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if constexpr (!AllocCounter::AUDIT) ++allocations;
+    auto alignment = static_cast<std::size_t>(align);
+    // `aligned_alloc` exige une taille multiple de l'alignement
+    size = (size + alignment - 1) / alignment * alignment;
+    void* p = std::aligned_alloc(alignment, size == 0 ? alignment : size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+#ifdef UI_ALLOC_AUDIT
+// Allocations C (raylib, glibc, bibliothèques tierces) : remplacement par
+// interposition des symboles de la glibc, qui restent l'allocateur réel
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+    ++allocations;
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+    ++allocations;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, std::size_t size) noexcept {
+    ++allocations;
+    return __libc_realloc(p, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+    ++allocations;
+    return __libc_memalign(alignment, size);
+}
+}
+#endif
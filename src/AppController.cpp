@@ -3,14 +3,21 @@
 #include "MusicUtils.hpp"
 #include "UI.hpp"
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
 #include <csignal>
 #include <cstring>
 #include <format>
 #include <sys/wait.h>
+#include <thread>
+#include <utility>
 
 namespace {
 constexpr float kConnRetryInterval{2.0f};     ///< Secondes entre tentatives
 constexpr float kResultDisplayDuration{2.5f}; ///< Durée affichage résultat
+constexpr float kReplyTimeout{5.0f}; ///< Délai de réponse à config/ready
+constexpr int32_t kDefaultStallMs{3000};      ///< Délai de blocage moteur
+constexpr double kMaxIdleWait{1.0}; ///< Attente maximale sans événement (s)
 } // namespace
 
 AppController::AppController() : comm_() {}
@@ -18,6 +25,10 @@ AppController::AppController() : comm_() {}
 AppController::~AppController() { this->cleanup(); }
 
 void AppController::init(int argc, char* argv[]) {
+    int32_t heartbeatMs = 0;
+    int32_t stallMs = kDefaultStallMs;
+    ThreadPolicy ioPolicy;
+    const char* keymapName = "azerty";
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--timeout") == 0 && i + 1 < argc) {
             timeoutMs_ = std::stoi(argv[i + 1]);
@@ -28,17 +39,64 @@ void AppController::init(int argc, char* argv[]) {
         } else if (std::strcmp(argv[i], "--fullscreen") == 0 ||
                    std::strcmp(argv[i], "-f") == 0) {
             fullscreen_ = true;
+        } else if (std::strcmp(argv[i], "--heartbeat") == 0 && i + 1 < argc) {
+            heartbeatMs = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--stall") == 0 && i + 1 < argc) {
+            stallMs = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--io-cpu") == 0 && i + 1 < argc) {
+            ioPolicy.cpu = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--io-fifo") == 0 && i + 1 < argc) {
+            ioPolicy.fifoPriority = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--io-nice") == 0 && i + 1 < argc) {
+            ioPolicy.nice = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--render-cpu") == 0 && i + 1 < argc) {
+            renderPolicy_.cpu = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--draw-cpu") == 0 && i + 1 < argc) {
+            drawPolicy_.cpu = std::stoi(argv[i + 1]);
+            ++i;
+        } else if (std::strcmp(argv[i], "--no-draw-thread") == 0) {
+            drawThread_ = false;
+        } else if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath_ = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            profiler_.toggle();
+        } else if (std::strcmp(argv[i], "--keymap") == 0 && i + 1 < argc) {
+            keymapName = argv[i + 1];
+            ++i;
         }
     }
 
     Logger::init();
     Logger::setVerbose(verbose_);
     Logger::log("[App] Initialisation de l'application");
+    if (heartbeatMs > 0) {
+        comm_.setHeartbeat(std::chrono::milliseconds(heartbeatMs),
+                           std::chrono::milliseconds(stallMs));
+        Logger::log("[App] Battement de cœur : ping {} ms, blocage {} ms",
+                    heartbeatMs, stallMs);
+    }
+
+    KeyLayout keymap = KeyLayout::AZERTY;
+    if (!PianoKeymap::parse(keymapName, keymap)) {
+        Logger::err("[App] Disposition inconnue : {} (qwerty, azerty, none)",
+                    keymapName);
+    }
+    keyboard_.setKeymap(keymap);
+
+    comm_.setThreadPolicy(ioPolicy);
+    assets_.preload(); // Décodage pendant le démarrage du moteur
 
-    std::string enginePath = findEngineBinary();
-    Logger::log("[App] Chemin moteur trouvé : {}", enginePath);
-    if (!enginePath.empty() && enginePath[0] == '/') {
-        enginePid_ = spawnEngine(enginePath);
+    enginePath_ = findEngineBinary();
+    Logger::log("[App] Chemin moteur trouvé : {}", enginePath_);
+    if (!enginePath_.empty() && enginePath_[0] == '/') {
+        enginePid_ = spawnEngine(enginePath_);
         usleep(500'000); // 500 ms wait for daemon startup
     }
 }
@@ -63,23 +121,50 @@ void AppController::run() {
         return;
     }
     SetTargetFPS(60);
+    text_.load(fontPath_);
+    assets_.upload();
+    if (!renderPolicy_.isDefault()) {
+        Logger::log("[App] Thread de rendu : {}",
+                    ThreadTuning::applyToCurrentThread(renderPolicy_));
+    }
+    // Un seul cœur : l'enregistrement resterait sur le chemin critique
+    if (drawThread_ && std::thread::hardware_concurrency() > 1) {
+        frames_.start(drawPolicy_);
+        Logger::log("[App] Images enregistrées sur un thread dédié");
+    }
 
-    // Initialisation session par défaut
-    profiles_ = {{"Utilisateur", 0, SKYBLUE}};
-    currentUserIdx_ = 0;
+    // Réveil de la boucle en attente dès qu'un message arrive
+    comm_.setWakeHandler([] { glfwPostEmptyEvent(); });
 
     Logger::log("[App] Boucle principale lancée");
+    loop(true);
+}
 
-    while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        Vector2 mouse = GetMousePosition();
-        Vector2 dpiScale = GetWindowScaleDPI();
-        mouse.x *= dpiScale.x;
-        mouse.y *= dpiScale.y;
+void AppController::replay(ScriptedInput& script) {
+    script.attach(comm_);
+    input_ = &script;
+    loop(false);
+    input_ = &windowInput_;
+    script.detach();
+}
 
-        bool clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-        float screenW = static_cast<float>(GetScreenWidth());
-        float screenH = static_cast<float>(GetScreenHeight());
+void AppController::loop(bool render) {
+    InputFrame in;
+    // Lit l'état et l'image de la boucle entre `record()` et `wait()`
+    frames_.setRecorder([this, &in](DrawList& out) {
+        auto scope = profiler_.measure(FrameSection::DRAW);
+        UI::record(*this, out, in.screenW, in.screenH);
+    });
+    double lastTime = input_->now();
+    bool redraw = true;
+    while (true) {
+        input_->poll(in);
+        if (in.quit) break;
+        auto dt = static_cast<float>(in.time - lastTime);
+        lastTime = in.time;
+        profiler_.beginFrame();
+        redraw = in.activity || redraw;
+        if (in.pressed(InputKey::PROFILER)) profiler_.toggle();
 
         // Gestion timeout de sécurité
         if (timeoutMs_ > 0) {
@@ -90,32 +175,40 @@ void AppController::run() {
             }
         }
 
-        // Décrémentation des minuteries
+        // Décrémentation des minuteries ; fondus animés image par image
         if (feedbackAlpha_ > 0.0f) {
             feedbackAlpha_ -= dt * 0.7f;
+            redraw = true;
         }
         if (errorTimer_ > 0.0f) {
             errorTimer_ -= dt;
+            redraw = redraw || errorTimer_ < 1.0f;
         }
-        if (lastResult_.active) {
-            lastResult_.displayTimer -= dt;
-            if (lastResult_.displayTimer <= 0.0f) {
-                lastResult_.active = false;
-                lastResult_.correct.clear();
-                lastResult_.incorrect.clear();
-                if (engState_ == EngineState::ENG_PLAYED) {
-                    comm_.send(Message("ready"));
-                    engState_ = EngineState::ENG_PLAYING;
-                }
+        redraw = session_.tick(dt) || redraw;
+
+        // Process socket messages
+        {
+            auto scope = profiler_.measure(FrameSection::MESSAGES);
+            redraw = processIncomingMessages() || redraw;
+            // Piano réel : les frappes de toute l'image en un seul relevé
+            KeyStates keys;
+            if (comm_.takeKeyStates(keys)) {
+                keyboard_.setLiveKeys(keys);
+                redraw = true;
             }
         }
 
-        // Process socket messages
-        processIncomingMessages();
+        // Récupération automatique d'un moteur bloqué (battement de cœur)
+        if (engState_ != EngineState::ENG_DISCONNECTED && comm_.isStalled()) {
+            recoverStalledEngine();
+            redraw = true;
+        }
 
         // Gestion déconnexion inattendue
         if (engState_ != EngineState::ENG_DISCONNECTED &&
             !comm_.isConnected()) {
+            redraw = true;
+            session_.cancel();
             engState_ = EngineState::ENG_DISCONNECTED;
             availableGames_.clear();
             if (appState_ == AppState::PLAY ||
@@ -130,24 +223,97 @@ void AppController::run() {
             if (connRetryTimer_ <= 0.0f) {
                 if (comm_.connect()) {
                     engState_ = EngineState::ENG_CONNECTED;
+                    redraw = true;
                 }
                 connRetryTimer_ = kConnRetryInterval;
             }
         }
 
         // Logique de l'application
-        updateLogic(dt, mouse, clicked, screenW, screenH);
+        {
+            auto scope = profiler_.measure(FrameSection::LOGIC);
+            refreshLayout(in.mouse, in.screenW, in.screenH);
+            updateLogic(in);
+            // L'état a pu changer
+            refreshLayout(in.mouse, in.screenW, in.screenH);
+            redraw = keyboard_.animate(dt) || redraw;
+            if (appState_ == AppState::PLAY && !isPaused_) {
+                redraw = falling_.animate(dt) || redraw;
+                redraw = effects_.animate(dt) || redraw;
+            }
+        }
 
-        // Rendu graphique
-        BeginDrawing();
-        ClearBackground(BLACK);
-        UI::draw(*this, mouse, screenW, screenH);
-        EndDrawing();
+        // Rendu graphique, ou attente d'un événement si rien n'a changé ;
+        // HUD affiché : rendu continu pour suivre chaque image. Une image
+        // enregistrée en parallèle n'est présentée qu'au tour suivant.
+        bool record = redraw || profiler_.visible();
+        if (record || frames_.ready()) {
+            if (render) {
+                // Enregistrement de cette image pendant la soumission et la
+                // présentation de la précédente ; état figé jusqu'à `wait()`
+                double pressed = -1.0;
+                if (record) {
+                    frames_.record();
+                    pressed = std::exchange(keyPressTime_, -1.0);
+                    // Sans thread, l'image est soumise aussitôt
+                    if (!frames_.threaded()) keyShownTime_ = pressed;
+                }
+                bool fresh = false;
+                {
+                    // Envoi du lot, échange des tampons et cadencement
+                    auto scope = profiler_.measure(FrameSection::PRESENT);
+                    BeginDrawing();
+                    ClearBackground(BLACK);
+                    fresh = frames_.submit();
+                    EndDrawing();
+                }
+                // Appui affiché : latence jusqu'à l'échange des tampons
+                if (fresh && keyShownTime_ >= 0.0) {
+                    profiler_.addInputLatency(input_->now() - keyShownTime_);
+                    keyShownTime_ = -1.0;
+                }
+                if (record) {
+                    frames_.wait();
+                    if (frames_.threaded()) keyShownTime_ = pressed;
+                }
+            } else if (record) {
+                // Rejeu : image enregistrée comme à l'écran, jamais soumise ;
+                // latence jusqu'à la fin de l'enregistrement
+                frames_.record();
+                frames_.wait();
+                frames_.discard();
+                if (keyPressTime_ >= 0.0) {
+                    profiler_.addInputLatency(input_->now() - keyPressTime_);
+                    keyPressTime_ = -1.0;
+                }
+            }
+            input_->present();
+            profiler_.endFrame();
+            redraw = false;
+        } else {
+            input_->wait(idleTimeout());
+        }
     }
 }
 
+double AppController::idleTimeout() const {
+    double wait = kMaxIdleWait;
+    auto earliest = [&wait](double seconds) {
+        if (seconds > 0.0) wait = std::min(wait, seconds);
+    };
+    earliest(session_.timeLeft());
+    earliest(keyboard_.chordTimeLeft(input_->now()));
+    if (errorTimer_ >= 1.0f) earliest(errorTimer_ - 1.0f);
+    if (engState_ == EngineState::ENG_DISCONNECTED) earliest(connRetryTimer_);
+    if (timeoutMs_ > 0) {
+        earliest((static_cast<float>(timeoutMs_) - timeoutTimer_) / 1000.0f);
+    }
+    return wait;
+}
+
 void AppController::cleanup() {
     Logger::log("[App] Nettoyage et fermeture…");
+    frames_.stop();
     if (appState_ == AppState::PLAY) {
         comm_.send(Message("quit"));
     }
@@ -156,6 +322,9 @@ void AppController::cleanup() {
 
     // Check if window was initialized to avoid crash on close
     if (IsWindowReady()) {
+        layers_.release();
+        text_.unload();
+        assets_.release();
         CloseWindow();
     }
 
@@ -166,124 +335,269 @@ void AppController::cleanup() {
     }
 }
 
-void AppController::processIncomingMessages() {
+void AppController::sendPlay(const Chord& chord, double now) {
+    if (engState_ != EngineState::ENG_PLAYING) {
+        Logger::debug("[App] Accord virtuel hors défi ignoré : {} note(s)",
+                      chord.notes.size());
+        return;
+    }
+    // Horodatages en millisecondes : premier appui, écarts, ancienneté
+    auto ms = [](double seconds) {
+        return std::to_string(std::llround(seconds * 1000.0));
+    };
+    std::string notes;
+    std::string offsets;
+    for (const NotePress& press : chord.notes) {
+        if (!notes.empty()) {
+            notes += ' ';
+            offsets += ' ';
+        }
+        notes +=
+            MusicUtils::noteName(press.midi, selectedScale_, selectedMode_);
+        offsets += ms(press.time - chord.start());
+    }
+    comm_.send(Message("play", {{"id", std::to_string(currentChallenge_.id)},
+                                {"notes", notes},
+                                {"time", ms(chord.start())},
+                                {"offsets", offsets},
+                                {"age", ms(now - chord.start())}}));
+}
+
+void AppController::recoverStalledEngine() {
+    LinkStats stats = comm_.linkStats();
+    Logger::err("[App] Moteur bloqué (RTT médian {} µs, {} ping / {} pong), "
+                "redémarrage du lien",
+                stats.p50Us, stats.pings, stats.pongs);
+    errorMsg_ = "Moteur bloqué, reconnexion…";
+    errorTimer_ = 5.0f;
+    session_.cancel();
+    comm_.disconnect();
+    comm_.clearQueue();
+
+    // Moteur lancé par l'interface : le relancer, la reconnexion suivra
+    if (enginePid_ > 0) {
+        kill(enginePid_, SIGKILL);
+        waitpid(enginePid_, nullptr, 0);
+        enginePid_ = spawnEngine(enginePath_);
+    }
+}
+
+bool AppController::processIncomingMessages() {
+    size_t depth = comm_.queueDepth();
+    size_t processed = 0;
     auto msgOpt = comm_.popMessage();
+    bool received = msgOpt.has_value();
     while (msgOpt.has_value()) {
+        ++processed;
         const Message& msg = msgOpt.value();
         const std::string& type = msg.getType();
 
-        if (type == "ack") {
-            if (msg.getField("status") == "ok") {
-                engState_ = EngineState::ENG_CONFIGURED;
-                comm_.send(Message("ready"));
-                engState_ = EngineState::ENG_PLAYING;
-            } else {
-                errorMsg_ = std::format("Config invalide : {}",
-                                        msg.getField("message"));
-                errorTimer_ = 5.0f;
-                appState_ = AppState::MENU;
-            }
+        if (session_.deliver(msg)) {
+            // Consommé par la coroutine de session
         } else if (type == "gametype") {
             availableGames_.push_back(
                 {msg.getField("id"), msg.getField("name"),
                  msg.hasField("keys") ? std::stoi(msg.getField("keys")) : 7});
-        } else if (type == "note") {
-            currentChallenge_.id =
-                msg.hasField("id") ? std::stoi(msg.getField("id")) : 0;
-            std::string noteName = msg.getField("note");
-            currentChallenge_.rawName = noteName;
-            currentChallenge_.displayText =
-                MusicUtils::noteDisplayLabel(noteName, selectedNotation_);
-            currentChallenge_.expectedNotes = {noteName};
-            currentChallenge_.isChord = false;
-            engState_ = EngineState::ENG_PLAYING;
-        } else if (type == "chord") {
-            currentChallenge_.id =
-                msg.hasField("id") ? std::stoi(msg.getField("id")) : 0;
-            currentChallenge_.rawName = msg.getField("name");
-            currentChallenge_.displayText = MusicUtils::chordDisplayLabel(
-                currentChallenge_.rawName, selectedNotation_);
-            currentChallenge_.expectedNotes =
-                MusicUtils::splitNotes(msg.getField("notes"));
-            currentChallenge_.isChord = true;
-            engState_ = EngineState::ENG_PLAYING;
-        } else if (type == "result") {
-            lastResult_.correct =
-                MusicUtils::splitNotes(msg.getField("correct"));
-            lastResult_.incorrect =
-                MusicUtils::splitNotes(msg.getField("incorrect"));
-            lastResult_.displayTimer = kResultDisplayDuration;
-            lastResult_.active = true;
-
-            bool isCorrect =
-                lastResult_.incorrect.empty() && !lastResult_.correct.empty();
-            bool isPartial =
-                !lastResult_.incorrect.empty() && !lastResult_.correct.empty();
-
-            static const char* encouragements[] = {
-                "MAGNIFIQUE !", "QUEL TALENT !", "PARFAIT !", "VIRTUOSE !"};
-            static const char* consolations[] = {"COURAGE !", "CONTINUE !",
-                                                 "PRESQUE !", "RYTHME !"};
-
-            if (isCorrect) {
-                feedbackMsg_ = encouragements[GetRandomValue(0, 3)];
-                feedbackColor_ = Colors::kOrEclatant;
-                scoreActuel_ += 10;
-            } else if (isPartial) {
-                feedbackMsg_ = consolations[GetRandomValue(0, 3)];
-                feedbackColor_ = Colors::kOrangeNote;
-                scoreActuel_ += 5;
-            } else {
-                feedbackMsg_ = consolations[GetRandomValue(0, 3)];
-                feedbackColor_ = Colors::kRougeErreur;
-            }
-            feedbackAlpha_ = 1.0f;
-            engState_ = EngineState::ENG_PLAYED;
-        } else if (type == "over") {
-            gameStats_.perfect = msg.hasField("perfect")
-                                     ? std::stoi(msg.getField("perfect"))
-                                     : 0;
-            gameStats_.partial = msg.hasField("partial")
-                                     ? std::stoi(msg.getField("partial"))
-                                     : 0;
-            gameStats_.total =
-                msg.hasField("total") ? std::stoi(msg.getField("total")) : 0;
-            gameStats_.duration = msg.hasField("duration")
-                                      ? std::stoll(msg.getField("duration"))
-                                      : 0LL;
-
-            if (scoreActuel_ > profiles_[currentUserIdx_].topScore) {
-                profiles_[currentUserIdx_].topScore = scoreActuel_;
-            }
-            engState_ = EngineState::ENG_CONNECTED;
-            appState_ = AppState::GAME_OVER;
         } else if (type == "error") {
             errorMsg_ = std::format("Erreur : {}", msg.getField("message"));
             errorTimer_ = 5.0f;
             if (msg.getField("code") == "internal") {
+                session_.cancel();
                 engState_ = EngineState::ENG_CONNECTED;
                 appState_ = AppState::MENU;
             }
+        } else {
+            Logger::debug("[App] Message hors séquence ignoré : {}", type);
         }
         msgOpt = comm_.popMessage();
     }
+    profiler_.countMessages(processed, depth);
+    return received;
 }
 
-void AppController::updateLogic(float /*dt*/, Vector2 mouse, bool clicked,
-                                float screenW, float screenH) {
+SessionTask AppController::playSession(std::string gtId) {
+    static const char* scaleStr[] = {"c", "d", "e", "f", "g", "a", "b"};
+    comm_.send(Message(
+        "config",
+        {{"game", gtId},
+         {"scale", scaleStr[static_cast<int>(selectedScale_)]},
+         {"mode", selectedMode_ == ModeChoice::MODE_MAJ ? "maj" : "min"}}));
+
+    auto ack = co_await session_.receive(kReplyTimeout, "ack");
+    if (ack && ack->getField("status") != "ok") {
+        errorMsg_ =
+            std::format("Config invalide : {}", ack->getField("message"));
+        errorTimer_ = 5.0f;
+        appState_ = AppState::MENU;
+        co_return;
+    }
+    if (ack) engState_ = EngineState::ENG_CONFIGURED;
+
+    while (ack) {
+        comm_.send(Message("ready"));
+        engState_ = EngineState::ENG_PLAYING;
+        auto challenge = co_await session_.receive(kReplyTimeout, "note",
+                                                   "chord", "over");
+        if (!challenge) break;
+        if (challenge->getType() == "over") {
+            finishGame(*challenge);
+            co_return;
+        }
+        applyChallenge(*challenge);
+
+        // Le joueur prend le temps qu'il veut (délai de 90 s côté moteur)
+        auto result = co_await session_.receive(SessionDriver::NO_TIMEOUT,
+                                                "result", "over");
+        if (!result) break;
+        if (result->getType() == "over") {
+            finishGame(*result);
+            co_return;
+        }
+        applyResult(*result);
+        engState_ = EngineState::ENG_PLAYED;
+
+        // Affichage du résultat, écourté par SUIVANT (SessionDriver::skip)
+        auto over = co_await session_.receive(kResultDisplayDuration, "over");
+        lastResult_ = {};
+        keyboard_.clearResult();
+        playView_.setResult(lastResult_);
+        if (over) {
+            finishGame(*over);
+            co_return;
+        }
+    }
+
+    Logger::err("[App] Pas de réponse du moteur, abandon de la partie");
+    errorMsg_ = "Le moteur ne répond pas";
+    errorTimer_ = 5.0f;
+    comm_.send(Message("quit"));
+    engState_ = EngineState::ENG_CONNECTED;
+    appState_ = AppState::MENU;
+}
+
+void AppController::applyChallenge(const Message& msg) {
+    currentChallenge_.id =
+        msg.hasField("id") ? std::stoi(msg.getField("id")) : 0;
+    if (msg.getType() == "note") {
+        currentChallenge_.rawName = msg.getField("note");
+        currentChallenge_.expectedNotes = {MusicUtils::spellNote(
+            currentChallenge_.rawName, selectedScale_, selectedMode_)};
+        currentChallenge_.displayText = MusicUtils::noteDisplayLabel(
+            currentChallenge_.expectedNotes[0], selectedNotation_);
+        currentChallenge_.isChord = false;
+    } else {
+        currentChallenge_.rawName = msg.getField("name");
+        currentChallenge_.displayText = MusicUtils::chordDisplayLabel(
+            currentChallenge_.rawName, selectedNotation_);
+        currentChallenge_.expectedNotes = MusicUtils::spellNotes(
+            MusicUtils::splitNotes(msg.getField("notes")), selectedScale_,
+            selectedMode_);
+        currentChallenge_.isChord = true;
+    }
+    keyboard_.setChallenge(currentChallenge_.expectedNotes);
+    playView_.setChallenge(currentChallenge_);
+    if (showFallingNotes_) {
+        falling_.setChallenge(currentChallenge_.expectedNotes,
+                              profiles_[currentUserIdx_].color);
+    }
+}
+
+void AppController::applyResult(const Message& msg) {
+    lastResult_.correct = MusicUtils::spellNotes(
+        MusicUtils::splitNotes(msg.getField("correct")), selectedScale_,
+        selectedMode_);
+    lastResult_.incorrect = MusicUtils::spellNotes(
+        MusicUtils::splitNotes(msg.getField("incorrect")), selectedScale_,
+        selectedMode_);
+    lastResult_.active = true;
+    keyboard_.setResult(lastResult_.correct, lastResult_.incorrect);
+    falling_.setResult(lastResult_.correct, lastResult_.incorrect);
+
+    bool isCorrect =
+        lastResult_.incorrect.empty() && !lastResult_.correct.empty();
+    bool isPartial =
+        !lastResult_.incorrect.empty() && !lastResult_.correct.empty();
+
+    static const char* encouragements[] = {"MAGNIFIQUE !", "QUEL TALENT !",
+                                           "PARFAIT !", "VIRTUOSE !"};
+    static const char* consolations[] = {"COURAGE !", "CONTINUE !",
+                                         "PRESQUE !", "RYTHME !"};
+
+    if (isCorrect) {
+        feedbackMsg_ = encouragements[GetRandomValue(0, 3)];
+        feedbackColor_ = Colors::kOrEclatant;
+        scoreActuel_ += 10;
+    } else if (isPartial) {
+        feedbackMsg_ = consolations[GetRandomValue(0, 3)];
+        feedbackColor_ = Colors::kOrangeNote;
+        scoreActuel_ += 5;
+    } else {
+        feedbackMsg_ = consolations[GetRandomValue(0, 3)];
+        feedbackColor_ = Colors::kRougeErreur;
+    }
+    feedbackAlpha_ = 1.0f;
+    burstResultKeys();
+    if (isCorrect || isPartial) {
+        Rectangle area = playView_.challengeRect();
+        effects_.popup({area.x + area.width / 2.0f, area.y},
+                       isCorrect ? "+10" : "+5", feedbackColor_);
+    }
+    playView_.setResult(lastResult_);
+    playView_.setScore(scoreActuel_, feedbackMsg_);
+}
+
+void AppController::burstResultKeys() {
+    constexpr size_t PER_KEY{192}; // Particules par note
+    Rectangle area = playView_.challengeRect();
+    Rectangle below{area.x, area.y + area.height, area.width, 0.0f};
+    auto burstAll = [&](const std::vector<std::string>& notes, Color color) {
+        for (const auto& note : notes) {
+            Rectangle key = keyboard_.keyBounds(MusicUtils::midiNumber(note));
+            bool visible = showKeyboard_ && key.width > 0.0f;
+            effects_.burst(visible ? key : below, color, PER_KEY);
+        }
+    };
+    burstAll(lastResult_.correct, Colors::kVertEclatant);
+    burstAll(lastResult_.incorrect, Colors::kRougeErreur);
+}
+
+void AppController::finishGame(const Message& msg) {
+    gameStats_.perfect =
+        msg.hasField("perfect") ? std::stoi(msg.getField("perfect")) : 0;
+    gameStats_.partial =
+        msg.hasField("partial") ? std::stoi(msg.getField("partial")) : 0;
+    gameStats_.total =
+        msg.hasField("total") ? std::stoi(msg.getField("total")) : 0;
+    gameStats_.duration =
+        msg.hasField("duration") ? std::stoll(msg.getField("duration")) : 0LL;
+
+    if (scoreActuel_ > profiles_[currentUserIdx_].topScore) {
+        profiles_[currentUserIdx_].topScore = scoreActuel_;
+    }
+    engState_ = EngineState::ENG_CONNECTED;
+    appState_ = AppState::GAME_OVER;
+}
+
+void AppController::refreshLayout(Vector2 mouse, float screenW,
+                                  float screenH) {
+    layout_.update({appState_, screenW, screenH, profiles_.size(),
+                    availableGames_.size(), isPaused_});
+    layout_.setPointer(mouse);
+}
+
+void AppController::updateLogic(const InputFrame& in) {
+    Hit hit = in.clicked ? layout_.hitTest(in.mouse) : Hit{};
     if (appState_ == AppState::PROFILE_SELECT) {
         if (isNamingProfile_) {
-            int key = GetCharPressed();
-            while (key > 0) {
+            for (char key : in.typed) {
                 if (key >= 32 && key <= 125 && inputName_.length() < 10) {
-                    inputName_ += static_cast<char>(key);
+                    inputName_ += key;
                 }
-                key = GetCharPressed();
             }
-            if (IsKeyPressed(KEY_BACKSPACE) && !inputName_.empty()) {
+            if (in.pressed(InputKey::BACKSPACE) && !inputName_.empty()) {
                 inputName_.pop_back();
             }
-            if (IsKeyPressed(KEY_ENTER) && !inputName_.empty()) {
+            if (in.pressed(InputKey::ENTER) && !inputName_.empty()) {
                 Color c = {static_cast<unsigned char>(GetRandomValue(100, 255)),
                            static_cast<unsigned char>(GetRandomValue(100, 255)),
                            static_cast<unsigned char>(GetRandomValue(100, 255)),
@@ -292,166 +606,82 @@ void AppController::updateLogic(float /*dt*/, Vector2 mouse, bool clicked,
                 isNamingProfile_ = false;
                 inputName_.clear();
             }
-            if (IsKeyPressed(KEY_ESCAPE)) {
+            if (in.pressed(InputKey::ESCAPE)) {
                 isNamingProfile_ = false;
                 inputName_.clear();
             }
-        } else if (clicked) {
-            float totalW = profiles_.size() * 200.0f +
-                           ((profiles_.size() < 4) ? 200.0f : 0.0f) - 20.0f;
-            float startX = screenW / 2.0f - totalW / 2.0f;
-
-            for (size_t i = 0; i < profiles_.size(); i++) {
-                Rectangle r = {startX + i * 200.0f, screenH / 2.0f - 110.0f,
-                               180.0f, 220.0f};
-                Rectangle rDel = {r.x + 150.0f, r.y + 5.0f, 25.0f, 25.0f};
-
-                if (CheckCollisionPointRec(mouse, rDel)) {
-                    profiles_.erase(profiles_.begin() + i);
-                    break;
-                }
-                if (CheckCollisionPointRec(mouse, r)) {
-                    currentUserIdx_ = static_cast<int32_t>(i);
-                    scoreActuel_ = 0;
-                    appState_ = AppState::MENU;
-                    break;
-                }
-            }
-
-            if (profiles_.size() < 4) {
-                Rectangle btnPlus = {startX + profiles_.size() * 200.0f,
-                                     screenH / 2.0f - 110.0f, 180.0f, 220.0f};
-                if (CheckCollisionPointRec(mouse, btnPlus)) {
-                    isNamingProfile_ = true;
-                }
-            }
+        } else if (hit.widget == Widget::PROFILE_DELETE) {
+            profiles_.erase(profiles_.begin() + hit.index);
+        } else if (hit.widget == Widget::PROFILE_CARD) {
+            currentUserIdx_ = hit.index;
+            scoreActuel_ = 0;
+            appState_ = AppState::MENU;
+        } else if (hit.widget == Widget::PROFILE_ADD) {
+            isNamingProfile_ = true;
         }
     } else if (appState_ == AppState::MENU) {
-        if (clicked) {
-            // Toggle clavier
-            Rectangle rKbd = {40, screenH - 80, 220, 40};
-            if (CheckCollisionPointRec(mouse, rKbd)) {
-                showKeyboard_ = !showKeyboard_;
-            }
-
-            // Sélection de gamme
-            float scaleStartX = screenW / 2.0f - (7.0f * 70.0f) / 2.0f;
-            for (int i = 0; i < 7; i++) {
-                Rectangle r = {scaleStartX + i * 70.0f, screenH * 0.75f, 60.0f,
-                               40.0f};
-                if (CheckCollisionPointRec(mouse, r)) {
-                    selectedScale_ = static_cast<ScaleChoice>(i);
-                }
-            }
-
-            // Sélection de mode
-            Rectangle rMaj = {screenW / 2.0f - 75.0f, screenH * 0.85f, 70.0f,
-                              40.0f};
-            Rectangle rMin = {screenW / 2.0f + 5.0f, screenH * 0.85f, 70.0f,
-                              40.0f};
-            if (CheckCollisionPointRec(mouse, rMaj)) {
-                selectedMode_ = ModeChoice::MODE_MAJ;
-            }
-            if (CheckCollisionPointRec(mouse, rMin)) {
-                selectedMode_ = ModeChoice::MODE_MIN;
-            }
-
-            // Clics sur les modes de jeu
-            for (size_t i = 0; i < availableGames_.size(); i++) {
-                Rectangle r = {screenW / 2.0f - 250.0f,
-                               screenH * 0.3f + i * 100.0f, 500.0f, 80.0f};
-                if (CheckCollisionPointRec(mouse, r)) {
-                    startGame(availableGames_[i].id);
-                }
-            }
-
-            Rectangle btnBack = {screenW / 2.0f - 150.0f, screenH * 0.92f,
-                                 300.0f, 30.0f};
-            if (CheckCollisionPointRec(mouse, btnBack)) {
-                appState_ = AppState::PROFILE_SELECT;
-            }
-
-            // Toggle notation
-            Rectangle rNotation = {screenW - 290, screenH - 80, 250, 40};
-            if (CheckCollisionPointRec(mouse, rNotation)) {
-                selectedNotation_ = static_cast<NotationMode>(
-                    (static_cast<int>(selectedNotation_) + 1) % 3);
-            }
+        switch (hit.widget) {
+        case Widget::MENU_KEYBOARD: showKeyboard_ = !showKeyboard_; break;
+        case Widget::MENU_FALLING:
+            showFallingNotes_ = !showFallingNotes_;
+            break;
+        case Widget::MENU_SCALE:
+            selectedScale_ = static_cast<ScaleChoice>(hit.index);
+            break;
+        case Widget::MENU_MODE:
+            selectedMode_ =
+                hit.index == 0 ? ModeChoice::MODE_MAJ : ModeChoice::MODE_MIN;
+            break;
+        case Widget::MENU_GAME:
+            startGame(availableGames_[static_cast<size_t>(hit.index)].id);
+            break;
+        case Widget::MENU_SWITCH_USER:
+            appState_ = AppState::PROFILE_SELECT;
+            break;
+        case Widget::MENU_NOTATION:
+            selectedNotation_ = static_cast<NotationMode>(
+                (static_cast<int>(selectedNotation_) + 1) % 3);
+            break;
+        default: break;
         }
     } else if (appState_ == AppState::PLAY) {
-        Rectangle btnPause = {screenW - 85.0f, 25.0f, 60.0f, 60.0f};
-        Rectangle btnMenu = {25.0f, 25.0f, 120.0f, 45.0f};
-        Rectangle btnReady = {160.0f, 25.0f, 160.0f, 45.0f};
-
-        if (clicked) {
-            if (CheckCollisionPointRec(mouse, btnPause)) {
-                isPaused_ = !isPaused_;
-            } else if (isPaused_) {
-                Rectangle btnResume = {screenW / 2.0f - 150.0f,
-                                       screenH / 2.0f - 50.0f, 300.0f, 60.0f};
-                Rectangle btnQuit = {screenW / 2.0f - 150.0f,
-                                     screenH / 2.0f + 30.0f, 300.0f, 60.0f};
-                if (CheckCollisionPointRec(mouse, btnResume)) {
-                    isPaused_ = false;
-                }
-                if (CheckCollisionPointRec(mouse, btnQuit)) {
-                    quitGame();
-                }
-            } else {
-                if (CheckCollisionPointRec(mouse, btnMenu)) {
-                    quitGame();
-                }
-                if (engState_ == EngineState::ENG_PLAYED &&
-                    CheckCollisionPointRec(mouse, btnReady)) {
-                    comm_.send(Message("ready"));
-                    engState_ = EngineState::ENG_PLAYING;
-                    lastResult_.active = false;
-                }
-            }
+        switch (hit.widget) {
+        case Widget::PLAY_PAUSE: isPaused_ = !isPaused_; break;
+        case Widget::PAUSE_RESUME: isPaused_ = false; break;
+        case Widget::PAUSE_QUIT:
+        case Widget::PLAY_MENU: quitGame(); break;
+        case Widget::PLAY_NEXT:
+            if (engState_ == EngineState::ENG_PLAYED) session_.skip();
+            break;
+        default: break;
         }
 
+        keyboard_.setLayout(getSelectedGameKeys(), in.screenW, in.screenH);
         if (!isPaused_ && showKeyboard_) {
-            handleVirtualKeyboardInput(screenH * 0.7f, mouse, screenW, screenH);
+            // Molette : zoom sous le pointeur ; flèches : une octave
+            if (in.wheel != 0.0f) keyboard_.zoom(in.wheel, in.mouse.x);
+            if (in.pressed(InputKey::LEFT)) keyboard_.scroll(-7.0f);
+            if (in.pressed(InputKey::RIGHT)) keyboard_.scroll(7.0f);
         }
+        // Clavier de l'ordinateur avant les pointeurs : ses appuis datent
+        // d'avant le relevé
+        double struck = keyboard_.setTypedKeys(
+            std::span(in.keyEvents).first(in.keyEventCount),
+            !isPaused_ && showKeyboard_);
+        if (struck >= 0.0 && keyPressTime_ < 0.0) keyPressTime_ = struck;
+        keyboard_.setPointers(std::span(in.pointers).first(in.pointerCount),
+                              !isPaused_ && showKeyboard_, in.time);
+        Chord chord;
+        while (keyboard_.takeChord(chord)) sendPlay(chord, in.time);
+        playView_.setLayout(in.screenW, in.screenH);
+        playView_.setPointer(in.mouse, showKeyboard_
+                                        ? keyboard_.pressedPitchClasses()
+                                        : uint16_t{0});
     } else if (appState_ == AppState::GAME_OVER) {
-        if (clicked) {
-            Rectangle btnBack = {screenW / 2.0f - 150.0f, screenH * 0.7f,
-                                 300.0f, 55.0f};
-            if (CheckCollisionPointRec(mouse, btnBack)) {
-                appState_ = AppState::MENU;
-                currentChallenge_ = {};
-                lastResult_ = {};
-            }
-        }
-    }
-}
-
-void AppController::handleVirtualKeyboardInput(float pianoY, Vector2 mouse,
-                                               float screenW, float screenH) {
-    for (auto& b : blanchesAppuyees_) b = false;
-    for (auto& b : noiresAppuyees_) b = false;
-
-    int32_t numKeys = getSelectedGameKeys();
-    int32_t numBlack = (numKeys / 7) * 5;
-    float wW = screenW / (float)numKeys;
-    float bW = wW * 0.6f;
-
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) && mouse.y > pianoY) {
-        bool hitBlack = false;
-        for (int i = 0; i < numBlack; i++) {
-            Rectangle rN = {(kBlackKeyIndices[i] + 1) * wW - bW / 2, pianoY, bW,
-                            (screenH - pianoY) * 0.6f};
-            if (CheckCollisionPointRec(mouse, rN)) {
-                noiresAppuyees_[i] = true;
-                hitBlack = true;
-                break;
-            }
-        }
-        if (!hitBlack) {
-            int idx = static_cast<int>(mouse.x / wW);
-            if (idx >= 0 && idx < numKeys) {
-                blanchesAppuyees_[idx] = true;
-            }
+        if (hit.widget == Widget::GAME_OVER_BACK) {
+            appState_ = AppState::MENU;
+            currentChallenge_ = {};
+            lastResult_ = {};
         }
     }
 }
@@ -474,17 +704,22 @@ void AppController::startGame(const std::string& gtId) {
     currentChallenge_ = {};
     lastResult_ = {};
     feedbackAlpha_ = 0.0f;
+    keyboard_.setChallenge({});
+    keyboard_.setTypedKeys({}, false); // Touches tenues hors partie
+    falling_.clear();
+    effects_.clear();
+    keyboard_.setStyle(profiles_[currentUserIdx_].color, selectedNotation_);
+    playView_.setSettings(selectedScale_, selectedMode_, selectedNotation_,
+                          profiles_[currentUserIdx_].color);
+    playView_.setChallenge(currentChallenge_);
+    playView_.setResult(lastResult_);
+    playView_.setScore(scoreActuel_, feedbackMsg_);
     appState_ = AppState::PLAY;
-
-    static const char* scaleStr[] = {"c", "d", "e", "f", "g", "a", "b"};
-    comm_.send(Message(
-        "config",
-        {{"game", gtId},
-         {"scale", scaleStr[static_cast<int>(selectedScale_)]},
-         {"mode", selectedMode_ == ModeChoice::MODE_MAJ ? "maj" : "min"}}));
+    session_.start(playSession(gtId));
 }
 
 void AppController::quitGame() {
+    session_.cancel();
     comm_.send(Message("quit"));
     comm_.clearQueue();
     engState_ = EngineState::ENG_CONNECTED;
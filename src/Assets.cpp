@@ -0,0 +1,75 @@
+#include "Assets.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <string>
+
+namespace {
+/// Fichier source de chaque image, dans l'ordre de `ImageAsset`
+constexpr std::array<std::string_view, static_cast<size_t>(ImageAsset::COUNT)>
+    IMAGE_FILES{"GClef.png"};
+
+/**
+ * @brief Millisecondes écoulées depuis un instant
+ * @return Durée en millisecondes
+ */
+int64_t msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+} // namespace
+
+const EmbeddedAsset* AssetStore::find(std::string_view name) {
+    auto assets = embedded();
+    auto it = std::ranges::find(assets, name, &EmbeddedAsset::name);
+    return it == assets.end() ? nullptr : &*it;
+}
+
+void AssetStore::preload() {
+    this->start_ = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < IMAGE_FILES.size(); ++i) {
+        const EmbeddedAsset* asset = find(IMAGE_FILES[i]);
+        if (asset == nullptr) {
+            Logger::err("[Assets] Ressource non embarquée : {}",
+                        IMAGE_FILES[i]);
+            continue;
+        }
+        // Décodage CPU seul (stb_image), sans contexte OpenGL
+        this->pending_[i] = std::async(std::launch::async, [asset] {
+            auto start = std::chrono::steady_clock::now();
+            size_t dot = asset->name.rfind('.');
+            std::string fileType(
+                dot == std::string_view::npos ? "" : asset->name.substr(dot));
+            Image image = LoadImageFromMemory(fileType.c_str(), asset->data,
+                                              static_cast<int>(asset->size));
+            Logger::debug("[Assets] {} décodé en {} ms", asset->name,
+                          msSince(start));
+            return image;
+        });
+    }
+}
+
+void AssetStore::upload() {
+    auto waitStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < IMAGE_FILES.size(); ++i) {
+        if (!this->pending_[i].valid()) continue;
+        Image image = this->pending_[i].get();
+        if (image.data == nullptr) {
+            Logger::err("[Assets] Échec décodage : {}", IMAGE_FILES[i]);
+            continue;
+        }
+        this->textures_[i] = LoadTextureFromImage(image);
+        SetTextureFilter(this->textures_[i], TEXTURE_FILTER_BILINEAR);
+        UnloadImage(image);
+    }
+    Logger::log("[Assets] {} image(s) prêtes : attente {} ms, {} ms depuis le "
+                "démarrage",
+                IMAGE_FILES.size(), msSince(waitStart), msSince(this->start_));
+}
+
+void AssetStore::release() {
+    for (auto& texture : this->textures_) {
+        if (texture.id != 0) UnloadTexture(texture);
+        texture = {};
+    }
+}
@@ -0,0 +1,33 @@
+#include "ChordGrouper.hpp"
+#include <algorithm>
+#include <utility>
+
+void ChordGrouper::press(int32_t midi, double time) {
+    this->update(time);
+    // Une touche rejouée dans la fenêtre ne compte qu'une fois
+    if (std::ranges::find(this->open_, midi, &NotePress::midi) !=
+        this->open_.end()) {
+        return;
+    }
+    this->open_.push_back({midi, time});
+}
+
+void ChordGrouper::update(double now) {
+    // Même échéance que `timeLeft`, au bit près : le réveil la franchit
+    if (this->open_.empty() || now < this->open_.front().time + WINDOW) {
+        return;
+    }
+    this->ready_.push_back({std::exchange(this->open_, {})});
+}
+
+bool ChordGrouper::pop(Chord& chord) {
+    if (this->ready_.empty()) return false;
+    chord = std::move(this->ready_.front());
+    this->ready_.pop_front();
+    return true;
+}
+
+void ChordGrouper::clear() {
+    this->open_.clear();
+    this->ready_.clear();
+}
@@ -1,7 +1,12 @@
 #include "Communication.hpp"
 #include "Logger.hpp"
+#include "MusicUtils.hpp"
 #include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
 #include <format>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <thread>
@@ -48,6 +53,34 @@ Message deserialize(std::string_view data) {
     return Message(std::move(type), std::move(fields));
 }
 
+size_t RttHistogram::bucketOf(uint32_t us) noexcept {
+    if (us == 0) return 0;
+    return std::min<size_t>(static_cast<size_t>(std::bit_width(us)) - 1,
+                            BUCKETS - 1);
+}
+
+void RttHistogram::record(uint32_t us) noexcept {
+    if (this->count_ == WINDOW) {
+        --this->buckets_[bucketOf(this->samples_[this->next_])];
+    } else {
+        ++this->count_;
+    }
+    this->samples_[this->next_] = us;
+    ++this->buckets_[bucketOf(us)];
+    this->next_ = (this->next_ + 1) % WINDOW;
+}
+
+uint32_t RttHistogram::percentile(double p) const noexcept {
+    if (this->count_ == 0) return 0;
+    auto rank = static_cast<size_t>(p * static_cast<double>(this->count_));
+    size_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        seen += this->buckets_[b];
+        if (seen > rank) return (2U << b) - 1; // Borne haute de la tranche
+    }
+    return (2U << (BUCKETS - 1)) - 1;
+}
+
 Communication::Communication(std::string path) : socketPath_(std::move(path)) {}
 
 Communication::~Communication() { this->disconnect(); }
@@ -57,6 +90,12 @@ bool Communication::connect() {
         Logger::log("[Comm] Déjà connecté");
         return true;
     }
+    if (this->loopback_) {
+        Logger::log("[Comm] Lien simulé");
+        this->releaseKeys();
+        this->loopbackUp_ = true;
+        return true;
+    }
 
     this->sockFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
     if (this->sockFd_ < 0) {
@@ -88,6 +127,10 @@ bool Communication::connect() {
     }
 
     Logger::log("[Comm] Connecté à {}", this->socketPath_);
+    this->releaseKeys();
+    this->stalled_ = false;
+    this->pingPending_ = false;
+    this->pingSentAt_ = std::chrono::steady_clock::now();
     this->running_ = true;
     this->listenerThread_ = std::thread(&Communication::listen, this);
 
@@ -95,7 +138,11 @@ bool Communication::connect() {
 }
 
 void Communication::disconnect() {
-    if (this->sockFd_ == -1 && !this->listenerThread_.joinable()) return;
+    this->loopbackUp_ = false;
+    if (this->sockFd_ == -1 && !this->listenerThread_.joinable()) {
+        this->releaseKeys(); // Lien simulé, ou déjà fermé
+        return;
+    }
 
     this->running_ = false;
     if (this->sockFd_ != -1) {
@@ -109,10 +156,12 @@ void Communication::disconnect() {
         this->listenerThread_.get_id() != std::this_thread::get_id()) {
         this->listenerThread_.join();
     }
+    // Après l'arrêt du thread d'écoute : plus aucun `noteon` ne peut suivre
+    this->releaseKeys();
 }
 
 bool Communication::isConnected() const noexcept {
-    return this->sockFd_ != -1 && this->running_;
+    return this->loopbackUp_ || (this->sockFd_ != -1 && this->running_);
 }
 
 void Communication::send(const Message& msg) {
@@ -120,8 +169,11 @@ void Communication::send(const Message& msg) {
         Logger::log("[Comm] Non connecté. Ne peut envoyer de message.");
         return;
     }
-    std::string data = serialize(msg);
-    if (::write(this->sockFd_, data.c_str(), data.length()) < 0) {
+    if (this->loopbackUp_) {
+        this->loopback_(msg);
+        return;
+    }
+    if (!this->writeRaw(serialize(msg))) {
         Logger::log("[Comm] Échec écriture socket.");
         this->disconnect();
     } else {
@@ -137,6 +189,57 @@ std::optional<Message> Communication::popMessage() {
     return msg;
 }
 
+void Communication::inject(Message msg) {
+    if (this->routeKey(msg)) {
+        this->wake();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->queueMutex_);
+        this->messageQueue_.push(std::move(msg));
+    }
+    this->wake();
+}
+
+bool Communication::routeKey(const Message& msg) {
+    const std::string& type = msg.getType();
+    bool on = type == "noteon";
+    if (!on && type != "noteoff") return false;
+    int32_t midi = MusicUtils::midiNumber(msg.getField("note"));
+    if (!on) {
+        std::lock_guard<std::mutex> lock(this->keysMutex_);
+        this->keys_.noteOff(midi);
+        return true;
+    }
+    uint32_t velocity = 0;
+    const std::string& field = msg.getField("velocity");
+    const char* last = field.data() + field.size();
+    auto [end, error] = std::from_chars(field.data(), last, velocity);
+    // Vélocité absente ou illisible : frappe moyenne
+    if (error != std::errc{} || end == field.data()) velocity = 64;
+    std::lock_guard<std::mutex> lock(this->keysMutex_);
+    this->keys_.noteOn(midi, static_cast<uint8_t>(std::min(velocity, 127U)));
+    return true;
+}
+
+void Communication::releaseKeys() {
+    std::lock_guard<std::mutex> lock(this->keysMutex_);
+    this->keys_.releaseAll();
+}
+
+bool Communication::takeKeyStates(KeyStates& states) {
+    std::lock_guard<std::mutex> lock(this->keysMutex_);
+    if (this->keys_.events == 0) return false;
+    states = this->keys_;
+    this->keys_.acknowledge();
+    return true;
+}
+
+size_t Communication::queueDepth() {
+    std::lock_guard<std::mutex> lock(this->queueMutex_);
+    return this->messageQueue_.size();
+}
+
 void Communication::clearQueue() {
     std::lock_guard<std::mutex> lock(this->queueMutex_);
     while (!this->messageQueue_.empty()) {
@@ -144,12 +247,103 @@ void Communication::clearQueue() {
     }
 }
 
+bool Communication::writeRaw(const std::string& data) {
+    std::lock_guard<std::mutex> lock(this->writeMutex_);
+    // Moteur disparu : EPIPE plutôt que SIGPIPE, qui tuerait l'interface
+    return ::send(this->sockFd_, data.c_str(), data.length(), MSG_NOSIGNAL) >=
+           0;
+}
+
+void Communication::setHeartbeat(std::chrono::milliseconds interval,
+                                 std::chrono::milliseconds stallDeadline) {
+    this->heartbeatInterval_ = interval;
+    this->stallDeadline_ = stallDeadline;
+}
+
+LinkStats Communication::linkStats() const {
+    std::lock_guard<std::mutex> lock(this->statsMutex_);
+    LinkStats snapshot = this->stats_;
+    snapshot.p50Us = this->rtt_.percentile(0.5);
+    snapshot.p99Us = this->rtt_.percentile(0.99);
+    snapshot.stalled = this->stalled_;
+    snapshot.buckets = this->rtt_.buckets();
+    return snapshot;
+}
+
+void Communication::heartbeat(std::chrono::steady_clock::time_point now) {
+    if (this->heartbeatInterval_.count() <= 0) return;
+    bool waiting = this->pingPending_ && !this->stalled_;
+    if (waiting && now - this->pingSentAt_ >= this->stallDeadline_) {
+        this->stalled_ = true;
+        waiting = false;
+        Logger::err("[Comm] Moteur bloqué : pas de pong depuis {} ms",
+                    this->stallDeadline_.count());
+        this->wake();
+    }
+    // Un seul ping en attente, sauf bloqué : sondes de reprise périodiques
+    if (waiting || now - this->pingSentAt_ < this->heartbeatInterval_) return;
+    ++this->pingSeq_;
+    this->pingSentAt_ = now;
+    this->pingPending_ = true;
+    if (!this->writeRaw(serialize(
+            Message("ping", {{"seq", std::to_string(this->pingSeq_)}})))) {
+        Logger::log("[Comm] Échec envoi ping");
+        this->running_ = false;
+        this->wake();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(this->statsMutex_);
+    ++this->stats_.pings;
+}
+
+void Communication::handlePong(const Message& msg,
+                               std::chrono::steady_clock::time_point now) {
+    if (!this->pingPending_ ||
+        msg.getField("seq") != std::to_string(this->pingSeq_)) {
+        Logger::debug("[Comm] pong inattendu ignoré");
+        return;
+    }
+    this->pingPending_ = false;
+    auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(
+        now - this->pingSentAt_);
+    if (this->stalled_.exchange(false)) {
+        Logger::log("[Comm] Moteur de nouveau réactif");
+    }
+    std::lock_guard<std::mutex> lock(this->statsMutex_);
+    ++this->stats_.pongs;
+    this->stats_.lastUs = static_cast<uint32_t>(rtt.count());
+    this->rtt_.record(this->stats_.lastUs);
+}
+
 void Communication::listen() {
     char buffer[4096];
     std::string currentMessageData;
+    if (!this->ioPolicy_.isDefault()) {
+        Logger::log("[Comm] Thread d'écoute : {}",
+                    ThreadTuning::applyToCurrentThread(this->ioPolicy_));
+    }
 
     while (this->running_) {
-        ssize_t bytesRead = ::read(this->sockFd_, buffer, sizeof(buffer) - 1);
+        auto now = std::chrono::steady_clock::now();
+        this->heartbeat(now);
+
+        // Attente bornée par la prochaine échéance du battement de cœur
+        int timeoutMs = -1;
+        if (this->heartbeatInterval_.count() > 0) {
+            bool waiting = this->pingPending_ && !this->stalled_;
+            auto due = this->pingSentAt_ + (waiting ? this->stallDeadline_
+                                                    : this->heartbeatInterval_);
+            auto wait =
+                std::chrono::duration_cast<std::chrono::milliseconds>(due - now)
+                    .count();
+            timeoutMs = static_cast<int>(std::max<int64_t>(wait, 0) + 1);
+        }
+        pollfd pfd{this->sockFd_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, timeoutMs);
+        if (ready == 0 || (ready < 0 && errno == EINTR)) continue;
+
+        ssize_t bytesRead =
+            ready > 0 ? ::read(this->sockFd_, buffer, sizeof(buffer) - 1) : -1;
 
         if (bytesRead > 0) {
             currentMessageData.append(buffer, static_cast<size_t>(bytesRead));
@@ -160,21 +354,29 @@ void Communication::listen() {
                 std::string_view msgData = std::string_view(currentMessageData)
                                                .substr(0, endOfMessagePos);
                 Message msg = deserialize(msgData);
+                currentMessageData.erase(0, endOfMessagePos + 2);
+                if (msg.getType() == "pong") {
+                    this->handlePong(msg, std::chrono::steady_clock::now());
+                    continue;
+                }
+                // Flot de touches : coalescé, hors de la file des messages
+                if (this->routeKey(msg)) continue;
 
                 {
                     std::lock_guard<std::mutex> lock(this->queueMutex_);
                     this->messageQueue_.push(std::move(msg));
                 }
                 Logger::debug("[Comm] Reçu: {}", msg.getType());
-
-                currentMessageData.erase(0, endOfMessagePos + 2);
             }
+            this->wake();
         } else if (bytesRead == 0) {
             Logger::log("[Comm] Le serveur a fermé la connexion");
             this->running_ = false;
+            this->wake();
         } else {
             if (this->running_) Logger::log("[Comm] Échec lecture socket");
             this->running_ = false;
+            this->wake();
         }
     }
 }
@@ -0,0 +1,195 @@
+#include "DrawList.hpp"
+#include "rlgl.h"
+#include <cmath>
+
+DrawList::DrawList() {
+    this->commands_.reserve(COMMAND_CAPACITY);
+    this->quads_.reserve(QUAD_CAPACITY);
+    this->chars_.reserve(CHAR_CAPACITY);
+}
+
+DrawCommand& DrawList::push(DrawOp op, Color color) {
+    DrawCommand& cmd = this->commands_.emplace_back();
+    cmd.op = op;
+    cmd.color = color;
+    return cmd;
+}
+
+DrawCommand& DrawList::quadRun(uint32_t texture) {
+    if (this->commands_.size() > this->sealed_) {
+        DrawCommand& last = this->commands_.back();
+        if (last.op == DrawOp::QUADS && last.texture.id == texture) {
+            return last;
+        }
+    }
+    DrawCommand& cmd = this->push(DrawOp::QUADS, BLANK);
+    cmd.texture.id = texture;
+    cmd.first = static_cast<uint32_t>(this->quads_.size());
+    return cmd;
+}
+
+void DrawList::clear() noexcept {
+    this->commands_.clear();
+    this->quads_.clear();
+    this->chars_.clear();
+    this->sealed_ = 0;
+}
+
+void DrawList::rect(Rectangle rec, Color color) {
+    this->push(DrawOp::RECT, color).rect = rec;
+}
+
+void DrawList::rectLines(Rectangle rec, float thick, Color color) {
+    DrawCommand& cmd = this->push(DrawOp::RECT_LINES, color);
+    cmd.rect = rec;
+    cmd.thick = thick;
+}
+
+void DrawList::line(Vector2 start, Vector2 end, float thick, Color color) {
+    DrawCommand& cmd = this->push(DrawOp::LINE, color);
+    cmd.rect = {start.x, start.y, end.x, end.y};
+    cmd.thick = thick;
+}
+
+void DrawList::ellipse(Vector2 center, float radiusH, float radiusV,
+                       Color color) {
+    this->push(DrawOp::ELLIPSE, color).rect = {center.x, center.y, radiusH,
+                                               radiusV};
+}
+
+void DrawList::circleLines(Vector2 center, float radius, Color color) {
+    this->push(DrawOp::CIRCLE_LINES, color).rect = {center.x, center.y, radius,
+                                                    radius};
+}
+
+void DrawList::texture(Texture2D texture, Vector2 pos, float scale,
+                       Color tint) {
+    DrawCommand& cmd = this->push(DrawOp::TEXTURE, tint);
+    cmd.texture = texture;
+    cmd.rect = {pos.x, pos.y, 0.0f, 0.0f};
+    cmd.thick = scale;
+}
+
+void DrawList::solid(Rectangle rec, Color color) {
+    // Texel blanc de la texture des formes : mêmes lots que DrawRectangle
+    Texture2D shapes = GetShapesTexture();
+    Rectangle src = GetShapesTextureRectangle();
+    float u = (src.x + src.width / 2.0f) / static_cast<float>(shapes.width);
+    float v = (src.y + src.height / 2.0f) / static_cast<float>(shapes.height);
+    this->quadRun(shapes.id).count++;
+    this->quads_.push_back({rec, u, v, u, v, color});
+}
+
+void DrawList::text(const TextRun& run, Vector2 pos, Color color) {
+    if (run.quads.empty()) return;
+    // Position entière comme DrawText, pour des glyphes nets
+    float x0 = std::floor(pos.x);
+    float y0 = std::floor(pos.y);
+    DrawCommand& cmd = this->quadRun(run.font->texture.id);
+    cmd.count += static_cast<uint32_t>(run.quads.size());
+    for (const GlyphQuad& q : run.quads) {
+        this->quads_.push_back({{x0 + q.dest.x, y0 + q.dest.y, q.dest.width,
+                                 q.dest.height},
+                                q.u0,
+                                q.v0,
+                                q.u1,
+                                q.v1,
+                                color});
+    }
+}
+
+void DrawList::plainText(std::string_view text, Vector2 pos, int32_t size,
+                         Color color) {
+    DrawCommand& cmd = this->push(DrawOp::PLAIN_TEXT, color);
+    cmd.rect = {pos.x, pos.y, 0.0f, 0.0f};
+    cmd.size = size;
+    cmd.first = static_cast<uint32_t>(this->chars_.size());
+    this->chars_.insert(this->chars_.end(), text.begin(), text.end());
+    this->chars_.push_back('\0');
+}
+
+void DrawList::replay(size_t first, size_t end,
+                      const BatchProbe& probe) const {
+    for (size_t i = first; i < end; ++i) {
+        if (probe) probe(false);
+        const DrawCommand& cmd = this->commands_[i];
+        const Rectangle& r = cmd.rect;
+        switch (cmd.op) {
+        case DrawOp::RECT: DrawRectangleRec(r, cmd.color); break;
+        case DrawOp::RECT_LINES:
+            DrawRectangleLinesEx(r, cmd.thick, cmd.color);
+            break;
+        case DrawOp::LINE:
+            DrawLineEx({r.x, r.y}, {r.width, r.height}, cmd.thick, cmd.color);
+            break;
+        case DrawOp::ELLIPSE:
+            DrawEllipse(static_cast<int>(r.x), static_cast<int>(r.y), r.width,
+                        r.height, cmd.color);
+            break;
+        case DrawOp::CIRCLE_LINES:
+            DrawCircleLines(static_cast<int>(r.x), static_cast<int>(r.y),
+                            r.width, cmd.color);
+            break;
+        case DrawOp::TEXTURE:
+            DrawTextureEx(cmd.texture, {r.x, r.y}, 0.0f, cmd.thick, cmd.color);
+            break;
+        case DrawOp::QUADS: {
+            // Un seul lot : texture liée une fois pour toute la plage
+            rlCheckRenderBatchLimit(4 * static_cast<int>(cmd.count));
+            rlSetTexture(cmd.texture.id);
+            rlBegin(RL_QUADS);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (uint32_t k = cmd.first; k < cmd.first + cmd.count; ++k) {
+                const DrawQuad& q = this->quads_[k];
+                const Rectangle& d = q.dest;
+                rlColor4ub(q.color.r, q.color.g, q.color.b, q.color.a);
+                rlTexCoord2f(q.u0, q.v0);
+                rlVertex2f(d.x, d.y);
+                rlTexCoord2f(q.u0, q.v1);
+                rlVertex2f(d.x, d.y + d.height);
+                rlTexCoord2f(q.u1, q.v1);
+                rlVertex2f(d.x + d.width, d.y + d.height);
+                rlTexCoord2f(q.u1, q.v0);
+                rlVertex2f(d.x + d.width, d.y);
+            }
+            rlEnd();
+            rlSetTexture(0);
+            break;
+        }
+        case DrawOp::PLAIN_TEXT:
+            DrawText(&this->chars_[cmd.first], static_cast<int>(r.x),
+                     static_cast<int>(r.y), cmd.size, cmd.color);
+            break;
+        case DrawOp::LAYER: {
+            CachedLayer& layer = *cmd.layer;
+            size_t last = cmd.first + cmd.count;
+            if (!layer.holds(r, cmd.key)) {
+                if (cmd.count == 0) {
+                    // Contenu non fourni : il le sera à l'image suivante
+                    layer.stale_ = true;
+                } else {
+                    // Changement de cible : le lot en cours part
+                    if (probe) probe(true);
+                    if (layer.begin(r)) {
+                        this->replay(cmd.first, last, probe);
+                        if (probe) probe(true);
+                        layer.end();
+                        layer.key_ = cmd.key;
+                    } else {
+                        // Pas de texture : rendu direct, contenu redemandé
+                        this->replay(cmd.first, last, probe);
+                        layer.stale_ = true;
+                    }
+                }
+            }
+            if (layer.holds(r, cmd.key)) layer.composite(probe);
+            i = last - 1; // Contenu déjà rejoué
+            break;
+        }
+        }
+    }
+}
+
+void DrawList::submit(const BatchProbe& probe) const {
+    this->replay(0, this->commands_.size(), probe);
+}
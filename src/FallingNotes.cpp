@@ -0,0 +1,80 @@
+#include "FallingNotes.hpp"
+#include "KeyboardModel.hpp"
+#include "MusicUtils.hpp"
+#include "SwapRemove.hpp"
+#include "Types.hpp"
+#include <algorithm>
+
+using namespace Colors;
+
+bool FallingNotes::spawn(int32_t midi, float fall, Color color) {
+    Vector2 span = KeyboardModel::keySpan(midi);
+    if (span.y <= 0.0f) return false;
+    if (this->count_ == CAPACITY) {
+        ++this->dropped_;
+        return false;
+    }
+    size_t i = this->count_++;
+    this->lane_[i] = span.x;
+    this->width_[i] = span.y;
+    this->fall_[i] = fall;
+    this->life_[i] = 1.0f;
+    this->decay_[i] = 0.0f;
+    this->midi_[i] = static_cast<int16_t>(midi);
+    this->color_[i] = color;
+    return true;
+}
+
+void FallingNotes::resolve(size_t i, Color color) {
+    this->color_[i] = color;
+    this->decay_[i] = 1.0f / FADE_TIME;
+}
+
+void FallingNotes::setChallenge(const std::vector<std::string>& expected,
+                                Color color) {
+    for (size_t i = 0; i < this->count_; ++i) {
+        if (this->decay_[i] == 0.0f) this->resolve(i, kRougeErreur);
+    }
+    for (const auto& note : expected) {
+        (void)this->spawn(MusicUtils::midiNumber(note), 0.0f, color);
+    }
+}
+
+void FallingNotes::setResult(const std::vector<std::string>& correct,
+                             const std::vector<std::string>& incorrect) {
+    // Notes en attente : justes si jouées, manquées sinon
+    for (size_t i = 0; i < this->count_; ++i) {
+        if (this->decay_[i] != 0.0f) continue;
+        bool hit = std::ranges::any_of(correct, [&](const std::string& n) {
+            return MusicUtils::midiNumber(n) == this->midi_[i];
+        });
+        this->resolve(i, hit ? kVertEclatant : kOrangeNote);
+    }
+    for (const auto& note : incorrect) {
+        if (this->spawn(MusicUtils::midiNumber(note), 1.0f, kRougeErreur)) {
+            this->resolve(this->count_ - 1, kRougeErreur);
+        }
+    }
+}
+
+void FallingNotes::clear() noexcept { this->count_ = 0; }
+
+bool FallingNotes::animate(float dt) {
+    size_t n = this->count_;
+    float step = dt / FALL_TIME;
+    bool moving = false;
+
+    // Passes de mise à jour sur des tableaux contigus : vectorisables
+    for (size_t i = 0; i < n; ++i) {
+        moving |= (this->fall_[i] < 1.0f) | (this->decay_[i] > 0.0f);
+        this->fall_[i] = std::min(this->fall_[i] + step, 1.0f);
+    }
+    for (size_t i = 0; i < n; ++i) this->life_[i] -= this->decay_[i] * dt;
+
+    // Notes éteintes remplacées par la dernière : réserve toujours compacte
+    this->count_ = swapRemove(
+        n, [this](size_t i) { return this->life_[i] > 0.0f; }, this->lane_,
+        this->width_, this->fall_, this->life_, this->decay_, this->midi_,
+        this->color_);
+    return moving;
+}
@@ -0,0 +1,36 @@
+#include "FrameArena.hpp"
+#include "Logger.hpp"
+#include <bit>
+
+void* FrameArena::Overflow::do_allocate(size_t bytes, size_t alignment) {
+    this->bytes_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::Overflow::do_deallocate(void* p, size_t bytes,
+                                         size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+FrameArena::FrameArena(size_t capacity)
+    : buffer_(std::make_unique<std::byte[]>(capacity)), capacity_(capacity) {
+    this->resource_.emplace(this->buffer_.get(), this->capacity_,
+                            &this->overflow_);
+}
+
+void FrameArena::reset() {
+    if (this->overflow_.bytes() == 0) {
+        // Retour au début du tampon d'origine, sans appel au tas
+        this->resource_->release();
+        return;
+    }
+    // Débordement : un tampon couvrant toute l'image suivante
+    size_t capacity = std::bit_ceil(this->capacity_ + this->overflow_.bytes());
+    this->resource_.reset();
+    this->overflow_.clear();
+    this->buffer_ = std::make_unique<std::byte[]>(capacity);
+    this->capacity_ = capacity;
+    this->resource_.emplace(this->buffer_.get(), this->capacity_,
+                            &this->overflow_);
+    Logger::log("[UI] Arène d'image agrandie à {} octets", capacity);
+}
@@ -0,0 +1,86 @@
+#include "FramePipeline.hpp"
+#include "Logger.hpp"
+#include <utility>
+
+FramePipeline::~FramePipeline() { this->stop(); }
+
+void FramePipeline::setRecorder(Recorder recorder) {
+    this->recorder_ = std::move(recorder);
+}
+
+void FramePipeline::start(ThreadPolicy policy) {
+    if (this->threaded()) return;
+    this->worker_ = std::thread(&FramePipeline::work, this, policy);
+}
+
+void FramePipeline::stop() {
+    if (!this->threaded()) return;
+    this->wait();
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->cv_.notify_all();
+    this->worker_.join();
+    this->stopping_ = false;
+}
+
+void FramePipeline::work(ThreadPolicy policy) {
+    if (!policy.isDefault()) {
+        Logger::log("[UI] Thread d'enregistrement : {}",
+                    ThreadTuning::applyToCurrentThread(policy));
+    }
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (true) {
+        this->cv_.wait(lock,
+                       [this] { return this->requested_ || this->stopping_; });
+        if (this->stopping_) return;
+
+        // Le thread principal n'écrit plus l'état jusqu'à `wait()`
+        lock.unlock();
+        DrawList& list = this->lists_[this->back_];
+        list.clear();
+        this->recorder_(list);
+        lock.lock();
+        this->requested_ = false;
+        this->cv_.notify_all();
+    }
+}
+
+void FramePipeline::flip() noexcept {
+    this->back_ ^= 1U;
+    this->recorded_ = true;
+    this->ready_ = true;
+}
+
+void FramePipeline::record() {
+    if (!this->threaded()) {
+        DrawList& list = this->lists_[this->back_];
+        list.clear();
+        this->recorder_(list);
+        this->flip();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->requested_ = true;
+    }
+    this->inFlight_ = true;
+    this->cv_.notify_all();
+}
+
+void FramePipeline::wait() {
+    if (!this->inFlight_) return;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->cv_.wait(lock, [this] { return !this->requested_; });
+    this->inFlight_ = false;
+    this->flip();
+}
+
+bool FramePipeline::submit() {
+    if (!this->recorded_) return false;
+    this->lists_[this->back_ ^ 1U].submit();
+    bool fresh = this->ready_;
+    this->ready_ = false;
+    return fresh;
+}
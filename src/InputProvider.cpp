@@ -0,0 +1,101 @@
+#include "InputProvider.hpp"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <utility>
+
+namespace {
+/// Touches raylib, dans l'ordre de `InputKey`
+constexpr std::array<int, static_cast<size_t>(InputKey::COUNT)> KEYS{
+    KEY_BACKSPACE, KEY_ENTER, KEY_ESCAPE, KEY_LEFT, KEY_RIGHT, KEY_F3};
+
+/// Touches reçues de GLFW depuis le dernier relevé ; les rappels tournent
+/// sur le thread principal, pendant `PollInputEvents` ou l'attente
+struct KeyQueue {
+    std::array<KeyEvent, InputFrame::MAX_KEY_EVENTS> events{};
+    size_t count{0};
+    GLFWkeyfun chained{nullptr}; ///< Rappel de raylib, appelé ensuite
+};
+
+KeyQueue keyQueue;
+
+/**
+ * @brief Rappel GLFW des touches : date l'événement à son arrivée, sur
+ * l'horloge de `GetTime`, puis laisse raylib le traiter
+ */
+void onKey(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    // Répétition automatique ignorée ; au-delà de la capacité, l'image
+    // perd les suivants (des dizaines de touches en 16 ms : jamais au clavier)
+    if (action != GLFW_REPEAT && keyQueue.count < keyQueue.events.size()) {
+        keyQueue.events[keyQueue.count++] = {key, action == GLFW_PRESS,
+                                             glfwGetTime()};
+    }
+    if (keyQueue.chained != nullptr) {
+        keyQueue.chained(window, key, scancode, action, mods);
+    }
+}
+} // namespace
+
+void RaylibInput::poll(InputFrame& frame) {
+    if (!this->hooked_) {
+        // Fenêtre de raylib : contexte courant du thread de rendu
+        GLFWwindow* window = glfwGetCurrentContext();
+        if (window != nullptr) {
+            keyQueue.chained = glfwSetKeyCallback(window, onKey);
+            this->hooked_ = true;
+        }
+    }
+    frame.quit = WindowShouldClose();
+    frame.time = GetTime();
+    frame.screenW = static_cast<float>(GetScreenWidth());
+    frame.screenH = static_cast<float>(GetScreenHeight());
+
+    Vector2 dpiScale = GetWindowScaleDPI();
+    Vector2 mouse = GetMousePosition();
+    frame.mouse = {mouse.x * dpiScale.x, mouse.y * dpiScale.y};
+    frame.clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+    frame.wheel = GetMouseWheelMove();
+
+    // Doigts posés, ou la souris sans écran tactile. Avec le backend GLFW de
+    // bureau, raylib ne rapporte qu'un point, copie du bouton gauche de la
+    // souris : plusieurs doigts simultanés demandent une raylib compilée pour
+    // PLATFORM_DRM (console du Raspberry Pi, événements tactiles evdev)
+    size_t count =
+        std::min(static_cast<size_t>(std::max(GetTouchPointCount(), 0)),
+                 frame.pointers.size());
+    for (size_t i = 0; i < count; ++i) {
+        auto index = static_cast<int>(i);
+        Vector2 p = GetTouchPosition(index);
+        frame.pointers[i] = {GetTouchPointId(index),
+                             {p.x * dpiScale.x, p.y * dpiScale.y}, true};
+    }
+    if (count == 0) {
+        frame.pointers[count++] = {-1, frame.mouse,
+                                   IsMouseButtonDown(MOUSE_LEFT_BUTTON)};
+    }
+    frame.pointerCount = count;
+
+    // Caractères hors ASCII ignorés : la saisie du nom n'en accepte pas
+    frame.typed.clear();
+    for (int c = GetCharPressed(); c > 0; c = GetCharPressed()) {
+        if (c < 128) frame.typed += static_cast<char>(c);
+    }
+    frame.keys.reset();
+    for (size_t k = 0; k < KEYS.size(); ++k) {
+        frame.keys.set(k, IsKeyPressed(KEYS[k]));
+    }
+    std::copy_n(keyQueue.events.begin(), keyQueue.count,
+                frame.keyEvents.begin());
+    frame.keyEventCount = std::exchange(keyQueue.count, 0);
+
+    Vector2 delta = GetMouseDelta();
+    frame.activity = delta.x != 0.0f || delta.y != 0.0f || frame.clicked ||
+                     IsMouseButtonReleased(MOUSE_LEFT_BUTTON) ||
+                     frame.wheel != 0.0f || GetKeyPressed() != 0 ||
+                     !frame.typed.empty() || frame.keyEventCount > 0 ||
+                     GetTouchPointCount() > 0 ||
+                     IsWindowResized();
+}
+
+void RaylibInput::wait(double seconds) { glfwWaitEventsTimeout(seconds); }
+
+double RaylibInput::now() const { return GetTime(); }
@@ -0,0 +1,516 @@
+#include "KeyboardModel.hpp"
+#include "MusicUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Colors;
+
+namespace {
+constexpr int32_t KEY_COUNT{KeyboardModel::LAST_MIDI -
+                            KeyboardModel::FIRST_MIDI + 1};
+constexpr float PIANO_TOP{0.7f};        ///< Haut du clavier, en part de hauteur
+constexpr float BLACK_HEIGHT{0.6f};     ///< Hauteur des noires / des blanches
+constexpr float BLACK_WIDTH{0.6f};      ///< Largeur des noires / des blanches
+constexpr float LABEL_MIN_WIDTH{90.0f}; ///< Largeur d'une blanche à libellé
+constexpr float HINT_MIN_WIDTH{24.0f};  ///< Largeur d'une blanche à lettre
+constexpr float HINT_MARGIN{8.0f};      ///< Écart des lettres au bas des noires
+constexpr float HINT_HEIGHT{16.0f};     ///< Hauteur des lettres
+constexpr float VIEW_EASE{12.0f};       ///< Vitesse de glissement, par seconde
+constexpr float VIEW_EPSILON{0.005f};   ///< Écart d'arrêt, en blanches
+constexpr float ZOOM_STEP{0.85f};       ///< Facteur de largeur par cran
+constexpr float LIVE_MIN{0.25f};        ///< Éclat de la frappe la plus douce
+constexpr float LIVE_HOLD{0.4f};        ///< Éclat d'une touche tenue, au plus
+constexpr float LIVE_DECAY{2.5f};       ///< Déclin par seconde, touche tenue
+constexpr float LIVE_RELEASE{10.0f};    ///< Déclin par seconde, relâchée
+constexpr float LIVE_EPSILON{0.01f};    ///< Écart d'arrêt du déclin
+
+/// Emplacement d'une touche dans les tableaux du modèle
+struct KeySlot {
+    bool black;
+    int16_t index;
+};
+
+/// Correspondances entre notes MIDI et touches, calculées à la compilation
+struct KeyTables {
+    std::array<KeySlot, KEY_COUNT> slot{}; ///< Par note MIDI depuis la0
+    std::array<int16_t, KeyboardModel::NUM_WHITE> whiteMidi{};
+    std::array<int16_t, KeyboardModel::NUM_BLACK> blackMidi{};
+    /// Blanche à droite de chaque noire (frontière qu'elle chevauche)
+    std::array<int16_t, KeyboardModel::NUM_BLACK> blackBoundary{};
+    /// Noire posée sur chaque frontière entre blanches, -1 si aucune
+    std::array<int16_t, KeyboardModel::NUM_WHITE + 1> blackAt{};
+};
+
+constexpr KeyTables buildTables() {
+    KeyTables t{};
+    t.blackAt.fill(-1);
+    int16_t white = 0;
+    int16_t black = 0;
+    for (int32_t midi = KeyboardModel::FIRST_MIDI;
+         midi <= KeyboardModel::LAST_MIDI; ++midi) {
+        int32_t pc = midi % 12;
+        bool isBlack = pc == 1 || pc == 3 || pc == 6 || pc == 8 || pc == 10;
+        auto& slot = t.slot[midi - KeyboardModel::FIRST_MIDI];
+        if (isBlack) {
+            slot = {true, black};
+            t.blackMidi[black] = static_cast<int16_t>(midi);
+            t.blackBoundary[black] = white;
+            t.blackAt[white] = black;
+            ++black;
+        } else {
+            slot = {false, white};
+            t.whiteMidi[white] = static_cast<int16_t>(midi);
+            ++white;
+        }
+    }
+    return t;
+}
+
+constexpr KeyTables KEYS{buildTables()};
+static_assert(KEYS.whiteMidi[KeyboardModel::NUM_WHITE - 1] ==
+              KeyboardModel::LAST_MIDI);
+static_assert(KEYS.blackBoundary[KeyboardModel::NUM_BLACK - 1] ==
+              KeyboardModel::NUM_WHITE - 2);
+
+/**
+ * @brief Touche d'une note MIDI
+ * @return Emplacement, `nullptr` hors du piano
+ */
+const KeySlot* slotOf(int32_t midi) {
+    if (midi < KeyboardModel::FIRST_MIDI || midi > KeyboardModel::LAST_MIDI) {
+        return nullptr;
+    }
+    return &KEYS.slot[midi - KeyboardModel::FIRST_MIDI];
+}
+
+/**
+ * @brief Compare deux couleurs composante par composante
+ * @return `true` si identiques
+ */
+bool sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+/**
+ * @brief Éclaire une couleur de remplissage
+ * @param base Couleur de la touche, transparente pour une blanche au repos
+ * @param light Couleur de l'éclat
+ * @param t Intensité, de 0 (base) à 1 (éclat)
+ * @return Couleur mélangée
+ */
+Color lightUp(Color base, Color light, float t) {
+    if (base.a == 0) base = {light.r, light.g, light.b, 0};
+    auto lerp = [t](unsigned char a, unsigned char b) {
+        auto from = static_cast<float>(a);
+        return static_cast<unsigned char>(from + (b - from) * t);
+    };
+    return {lerp(base.r, light.r), lerp(base.g, light.g),
+            lerp(base.b, light.b), lerp(base.a, light.a)};
+}
+} // namespace
+
+KeyboardModel::KeyboardModel() {
+    this->typed_.fill(-1);
+    this->relabel();
+}
+
+void KeyboardModel::layout() {
+    if (this->screenW_ <= 0.0f) return;
+    float wW = this->screenW_ / this->viewWidth_;
+    float bW = wW * BLACK_WIDTH;
+    float top = this->screenH_ * PIANO_TOP;
+    float height = this->screenH_ - top;
+    this->keyWidth_ = wW;
+    this->showLabels_ = wW >= LABEL_MIN_WIDTH;
+    this->showHints_ = wW >= HINT_MIN_WIDTH;
+    float hintY = top + height * BLACK_HEIGHT + HINT_MARGIN;
+
+    this->firstWhite_ = std::clamp(
+        static_cast<int32_t>(std::floor(this->viewStart_)), 0, NUM_WHITE);
+    this->endWhite_ = std::clamp(
+        static_cast<int32_t>(std::ceil(this->viewStart_ + this->viewWidth_)),
+        this->firstWhite_, NUM_WHITE);
+    for (int32_t i = this->firstWhite_; i < this->endWhite_; ++i) {
+        float x = (static_cast<float>(i) - this->viewStart_) * wW;
+        this->whiteRect_[i] = {x, top, wW - 2.0f, height};
+        this->whiteLabelPos_[i] = {x + wW / 2.0f, top + height - 30.0f};
+        this->whiteHintPos_[i] = {x + wW / 2.0f, hintY};
+    }
+
+    // Noires dont la frontière touche la fenêtre, bornes en O(log n)
+    auto first = std::ranges::lower_bound(KEYS.blackBoundary,
+                                          this->firstWhite_);
+    auto end = std::ranges::upper_bound(KEYS.blackBoundary, this->endWhite_);
+    this->firstBlack_ =
+        static_cast<int32_t>(first - KEYS.blackBoundary.begin());
+    this->endBlack_ = static_cast<int32_t>(end - KEYS.blackBoundary.begin());
+    for (int32_t i = this->firstBlack_; i < this->endBlack_; ++i) {
+        float x = (static_cast<float>(KEYS.blackBoundary[i]) -
+                   this->viewStart_) * wW;
+        this->blackRect_[i] = {x - bW / 2.0f, top, bW, height * BLACK_HEIGHT};
+        this->blackHintPos_[i] = {x, hintY - 2.0f * HINT_MARGIN - HINT_HEIGHT};
+    }
+    this->rehint();
+}
+
+void KeyboardModel::rehint() {
+    int32_t base = this->keymap_.enabled() ? this->typedBase() : -1;
+    if (base == this->hintBase_) return;
+    this->hintBase_ = base;
+    this->whiteHint_.fill(0);
+    this->blackHint_.fill(0);
+    if (base < 0) return;
+    for (int32_t slot = 0; slot < static_cast<int32_t>(PianoKeymap::SLOTS);
+         ++slot) {
+        const KeySlot* key = slotOf(base + PianoKeymap::offset(slot));
+        if (key == nullptr) continue;
+        // Deux touches pour la même note : la première de la table s'affiche
+        char& hint = key->black ? this->blackHint_[key->index]
+                                : this->whiteHint_[key->index];
+        if (hint == 0) hint = this->keymap_.label(slot);
+    }
+}
+
+void KeyboardModel::relabel() {
+    for (int32_t i = 0; i < NUM_WHITE; ++i) {
+        // La0 est la sixième blanche de l'octave (do = 0)
+        this->whiteLabel_[i] =
+            MusicUtils::getNotationLabel(i + 5, this->notation_);
+    }
+}
+
+void KeyboardModel::recolor() {
+    Color hover = Fade(this->userColor_, 0.3f);
+    for (int32_t i = 0; i < NUM_WHITE; ++i) {
+        uint8_t f = this->whiteFlags_[i];
+        this->whiteFill_[i] = (f & KEY_WRONG) != 0      ? kRougeErreur
+                              : (f & KEY_CORRECT) != 0  ? kVertEclatant
+                              : (f & KEY_EXPECTED) != 0 ? kOrangeNote
+                              : (f & KEY_PRESSED) != 0  ? this->userColor_
+                              : (f & KEY_HOVER) != 0    ? hover
+                                                        : BLANK;
+        if (this->whiteLive_[i] > 0.0f) {
+            this->whiteFill_[i] = lightUp(this->whiteFill_[i], this->userColor_,
+                                          this->whiteLive_[i]);
+        }
+        this->whiteText_[i] =
+            this->whiteFill_[i].a != 0 ? kVertFonce : kVertEclatant;
+    }
+    Color blackHover = Fade(this->userColor_, 0.6f);
+    for (int32_t i = 0; i < NUM_BLACK; ++i) {
+        uint8_t f = this->blackFlags_[i];
+        this->blackFill_[i] = (f & KEY_WRONG) != 0      ? kRougeErreur
+                              : (f & KEY_CORRECT) != 0  ? kVertEclatant
+                              : (f & KEY_EXPECTED) != 0 ? kOrangeNote
+                              : (f & KEY_PRESSED) != 0  ? this->userColor_
+                              : (f & KEY_HOVER) != 0    ? blackHover
+                                                        : BLACK_FILL;
+        if (this->blackLive_[i] > 0.0f) {
+            this->blackFill_[i] = lightUp(this->blackFill_[i], this->userColor_,
+                                          this->blackLive_[i]);
+        }
+    }
+}
+
+void KeyboardModel::clearFlag(uint8_t flag) {
+    auto mask = static_cast<uint8_t>(~flag);
+    for (auto& f : this->whiteFlags_) f &= mask;
+    for (auto& f : this->blackFlags_) f &= mask;
+}
+
+void KeyboardModel::markNotes(const std::vector<std::string>& notes,
+                              uint8_t flag) {
+    for (const auto& n : notes) this->flagKey(MusicUtils::midiNumber(n), flag);
+}
+
+void KeyboardModel::clampTarget() {
+    this->targetWidth_ = std::clamp(this->targetWidth_, MIN_VISIBLE,
+                                    static_cast<float>(NUM_WHITE));
+    this->targetStart_ =
+        std::clamp(this->targetStart_, 0.0f,
+                   static_cast<float>(NUM_WHITE) - this->targetWidth_);
+}
+
+void KeyboardModel::setLayout(int32_t numKeys, float screenW, float screenH) {
+    bool resized = screenW != this->screenW_ || screenH != this->screenH_;
+    if (numKeys != this->numKeys_) {
+        // Nouveau type de jeu : largeur par défaut, sans glissement
+        this->numKeys_ = numKeys;
+        this->targetWidth_ = static_cast<float>(numKeys);
+        this->clampTarget();
+        this->viewStart_ = this->targetStart_;
+        this->viewWidth_ = this->targetWidth_;
+    } else if (!resized) {
+        return;
+    }
+    this->screenW_ = screenW;
+    this->screenH_ = screenH;
+    this->layout();
+}
+
+void KeyboardModel::setStyle(Color userColor, NotationMode notation) {
+    bool relabel = notation != this->notation_;
+    if (!relabel && sameColor(userColor, this->userColor_)) return;
+    this->userColor_ = userColor;
+    this->notation_ = notation;
+    if (relabel) this->relabel();
+    this->recolor();
+}
+
+void KeyboardModel::setChallenge(const std::vector<std::string>& expected) {
+    this->clearFlag(KEY_EXPECTED | KEY_CORRECT | KEY_WRONG);
+    this->markNotes(expected, KEY_EXPECTED);
+    this->recolor();
+
+    // Étendue des notes attendues, en blanches (une noire chevauche deux)
+    int32_t low = NUM_WHITE;
+    int32_t high = -1;
+    for (const auto& n : expected) {
+        const KeySlot* key = slotOf(MusicUtils::midiNumber(n));
+        if (key == nullptr) continue;
+        int32_t left = key->black ? KEYS.blackBoundary[key->index] - 1
+                                  : key->index;
+        int32_t right = key->black ? left + 1 : key->index;
+        low = std::min(low, left);
+        high = std::max(high, right);
+    }
+    if (high < 0) return;
+    auto lowF = static_cast<float>(low);
+    auto highF = static_cast<float>(high + 1);
+    this->targetWidth_ = std::max(this->targetWidth_, highF - lowF + 1.0f);
+    if (lowF < this->targetStart_) {
+        this->targetStart_ = lowF - 0.5f;
+    } else if (highF > this->targetStart_ + this->targetWidth_) {
+        this->targetStart_ = highF + 0.5f - this->targetWidth_;
+    }
+    this->clampTarget();
+}
+
+void KeyboardModel::setResult(const std::vector<std::string>& correct,
+                              const std::vector<std::string>& incorrect) {
+    this->clearFlag(KEY_CORRECT | KEY_WRONG);
+    this->markNotes(correct, KEY_CORRECT);
+    this->markNotes(incorrect, KEY_WRONG);
+    this->recolor();
+}
+
+void KeyboardModel::clearResult() {
+    this->clearFlag(KEY_CORRECT | KEY_WRONG);
+    this->recolor();
+}
+
+Vector2 KeyboardModel::keySpan(int32_t midi) {
+    const KeySlot* key = slotOf(midi);
+    if (key == nullptr) return {0.0f, 0.0f};
+    if (!key->black) return {static_cast<float>(key->index), 1.0f};
+    // Noire centrée sur la frontière qu'elle chevauche, comme `layout`
+    auto boundary = static_cast<float>(KEYS.blackBoundary[key->index]);
+    return {boundary - BLACK_WIDTH / 2.0f, BLACK_WIDTH};
+}
+
+Rectangle KeyboardModel::keyBounds(int32_t midi) const {
+    Vector2 span = keySpan(midi);
+    float top = this->screenH_ * PIANO_TOP;
+    float left = (span.x - this->viewStart_) * this->keyWidth_;
+    float width = span.y * this->keyWidth_;
+    if (left + width <= 0.0f || left >= this->screenW_) width = 0.0f;
+    return {left, top, width, this->screenH_ - top};
+}
+
+int32_t KeyboardModel::typedBase() const {
+    // Première blanche visible au moins à moitié, puis premier do à partir
+    // d'elle ; les do sont les blanches 2 + 7k (do1 = 24)
+    auto first = static_cast<int32_t>(std::ceil(this->targetStart_ - 0.5f));
+    int32_t octave = first <= 2 ? 0 : (first - 2 + 6) / 7;
+    return 24 + 12 * octave;
+}
+
+int32_t KeyboardModel::keyAt(Vector2 point) const {
+    float top = this->screenH_ * PIANO_TOP;
+    if (this->keyWidth_ <= 0.0f || point.y <= top) return -1;
+    // Position en blanches, puis noire éventuelle sur la frontière voisine
+    float u = this->viewStart_ + point.x / this->keyWidth_;
+    float boundary = std::round(u);
+    auto b = static_cast<int32_t>(boundary);
+    bool inBlackRow = point.y < top + (this->screenH_ - top) * BLACK_HEIGHT;
+    if (inBlackRow && std::abs(u - boundary) <= BLACK_WIDTH / 2.0f && b > 0 &&
+        b < NUM_WHITE && KEYS.blackAt[b] >= 0) {
+        return KEYS.blackMidi[KEYS.blackAt[b]];
+    }
+    auto w = static_cast<int32_t>(std::floor(u));
+    return u >= 0.0f && w < NUM_WHITE ? KEYS.whiteMidi[w] : -1;
+}
+
+void KeyboardModel::flagKey(int32_t midi, uint8_t flags) {
+    const KeySlot* key = slotOf(midi);
+    if (key == nullptr) return;
+    if (key->black) {
+        this->blackFlags_[key->index] |= flags;
+    } else {
+        this->whiteFlags_[key->index] |= flags;
+    }
+}
+
+void KeyboardModel::setPointers(std::span<const Pointer> pointers,
+                                bool enabled, double now) {
+    this->chords_.update(now);
+    int32_t hover = -1;
+    std::array<Hold, MAX_POINTERS> holds{};
+    size_t count = 0;
+    for (const Pointer& p : pointers) {
+        int32_t midi = enabled ? this->keyAt(p.position) : -1;
+        if (!p.down) {
+            hover = midi;
+            continue;
+        }
+        if (count == MAX_POINTERS) break;
+        holds[count++] = {p.id, midi};
+        // Nouvel appui : doigt posé ou glissé sur une autre touche
+        auto previous = std::span(this->holds_).first(this->holdCount_);
+        auto it = std::ranges::find(previous, p.id, &Hold::pointer);
+        if (midi >= 0 && (it == previous.end() || it->midi != midi)) {
+            this->chords_.press(midi, now);
+        }
+    }
+    if (hover == this->hoverMidi_ && count == this->holdCount_ &&
+        std::equal(holds.begin(), holds.begin() + count,
+                   this->holds_.begin())) {
+        return;
+    }
+    this->hoverMidi_ = hover;
+    this->holds_ = holds;
+    this->holdCount_ = count;
+    this->reflag();
+}
+
+void KeyboardModel::setKeymap(KeyLayout layout) {
+    this->keymap_.setLayout(layout);
+    this->typed_.fill(-1);
+    this->reflag();
+    // Lettres de la nouvelle disposition, même do de départ
+    this->hintBase_ = -1;
+    this->whiteHint_.fill(0);
+    this->blackHint_.fill(0);
+    this->rehint();
+}
+
+double KeyboardModel::setTypedKeys(std::span<const KeyEvent> events,
+                                   bool enabled) {
+    double first = -1.0;
+    bool changed = false;
+    int32_t base = this->typedBase();
+    for (const KeyEvent& e : events) {
+        int32_t slot = enabled ? this->keymap_.slotOf(e.key) : -1;
+        if (slot < 0) continue;
+        int8_t& held = this->typed_[static_cast<size_t>(slot)];
+        if (!e.down) {
+            changed = changed || held >= 0;
+            held = -1;
+            continue;
+        }
+        // Touche déjà tenue : appui répété par le système, ignoré
+        if (held >= 0) continue;
+        int32_t midi = base + PianoKeymap::offset(slot);
+        if (slotOf(midi) == nullptr) continue;
+        held = static_cast<int8_t>(midi);
+        changed = true;
+        this->chords_.press(midi, e.time);
+        if (first < 0.0) first = e.time;
+    }
+    if (!enabled) {
+        // Pause, clavier masqué : les touches tenues sont relâchées
+        changed = std::ranges::max(this->typed_) >= 0;
+        this->typed_.fill(-1);
+    }
+    if (changed) this->reflag();
+    return first;
+}
+
+void KeyboardModel::reflag() {
+    this->clearFlag(KEY_HOVER | KEY_PRESSED);
+    this->pressedPitchClasses_ = 0;
+    this->flagKey(this->hoverMidi_, KEY_HOVER);
+    auto press = [this](int32_t midi, uint8_t flags) {
+        if (midi < 0) return;
+        this->flagKey(midi, flags);
+        this->pressedPitchClasses_ |= static_cast<uint16_t>(1U << (midi % 12));
+    };
+    for (size_t i = 0; i < this->holdCount_; ++i) {
+        press(this->holds_[i].midi, KEY_HOVER | KEY_PRESSED);
+    }
+    for (int8_t midi : this->typed_) press(midi, KEY_PRESSED);
+    this->recolor();
+}
+
+void KeyboardModel::setLiveKeys(const KeyStates& states) {
+    this->clearFlag(KEY_LIVE);
+    for (int32_t midi = FIRST_MIDI; midi <= LAST_MIDI; ++midi) {
+        auto n = static_cast<size_t>(midi);
+        if (states.held[n]) this->flagKey(midi, KEY_LIVE);
+        if (!states.struck[n]) continue;
+        // Frappe : éclat selon la vélocité, même si déjà relâchée
+        float level = std::max(states.velocity[n] / 127.0f, LIVE_MIN);
+        const KeySlot& key = KEYS.slot[midi - FIRST_MIDI];
+        if (key.black) {
+            this->blackLive_[key.index] = level;
+        } else {
+            this->whiteLive_[key.index] = level;
+        }
+    }
+    this->recolor();
+}
+
+bool KeyboardModel::fadeLive(float dt) {
+    float hold = std::exp(-LIVE_DECAY * dt);
+    float release = std::exp(-LIVE_RELEASE * dt);
+    bool changed = false;
+    auto fade = [&](std::span<float> live, std::span<const uint8_t> flags) {
+        for (size_t i = 0; i < live.size(); ++i) {
+            if (live[i] <= 0.0f) continue;
+            // Tenue : vers l'éclat de maintien ; relâchée : vers 0
+            bool held = (flags[i] & KEY_LIVE) != 0;
+            float rest = held ? std::min(live[i], LIVE_HOLD) : 0.0f;
+            float next = rest + (live[i] - rest) * (held ? hold : release);
+            if (next - rest < LIVE_EPSILON) next = rest;
+            changed = changed || next != live[i];
+            live[i] = next;
+        }
+    };
+    fade(this->whiteLive_, this->whiteFlags_);
+    fade(this->blackLive_, this->blackFlags_);
+    if (changed) this->recolor();
+    return changed;
+}
+
+void KeyboardModel::zoom(float steps, float anchorX) {
+    if (this->screenW_ <= 0.0f || steps == 0.0f) return;
+    // La blanche sous le pointeur garde sa place à l'écran
+    float share = std::clamp(anchorX / this->screenW_, 0.0f, 1.0f);
+    float anchor = this->targetStart_ + share * this->targetWidth_;
+    this->targetWidth_ *= std::pow(ZOOM_STEP, steps);
+    this->clampTarget();
+    this->targetStart_ = anchor - share * this->targetWidth_;
+    this->clampTarget();
+}
+
+void KeyboardModel::scroll(float whites) {
+    this->targetStart_ += whites;
+    this->clampTarget();
+}
+
+bool KeyboardModel::animate(float dt) {
+    bool lit = this->fadeLive(dt);
+    float dStart = this->targetStart_ - this->viewStart_;
+    float dWidth = this->targetWidth_ - this->viewWidth_;
+    if (dStart == 0.0f && dWidth == 0.0f) return lit;
+    if (std::abs(dStart) < VIEW_EPSILON && std::abs(dWidth) < VIEW_EPSILON) {
+        this->viewStart_ = this->targetStart_;
+        this->viewWidth_ = this->targetWidth_;
+    } else {
+        float k = 1.0f - std::exp(-VIEW_EASE * dt);
+        this->viewStart_ += dStart * k;
+        this->viewWidth_ += dWidth * k;
+    }
+    this->layout();
+    return true;
+}
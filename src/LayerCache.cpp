@@ -0,0 +1,65 @@
+#include "LayerCache.hpp"
+#include "rlgl.h"
+
+bool CachedLayer::begin(Rectangle bounds) {
+    auto width = static_cast<int>(bounds.width);
+    auto height = static_cast<int>(bounds.height);
+    if (width <= 0 || height <= 0) return false;
+    if (this->target_.id == 0 || this->target_.texture.width != width ||
+        this->target_.texture.height != height) {
+        this->release();
+        this->target_ = LoadRenderTexture(width, height);
+        if (this->target_.id == 0) return false;
+    }
+    this->bounds_ = bounds;
+    BeginTextureMode(this->target_);
+    ClearBackground(BLANK);
+    rlPushMatrix();
+    rlTranslatef(-bounds.x, -bounds.y, 0.0f);
+
+    // Alpha cumulé correctement : la texture contient des couleurs
+    // prémultipliées, recopiées ensuite en BLEND_ALPHA_PREMULTIPLY
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE,
+                              RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                              RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return true;
+}
+
+void CachedLayer::end() {
+    EndBlendMode();
+    rlPopMatrix();
+    EndTextureMode();
+    this->valid_ = true;
+}
+
+void CachedLayer::composite(const BatchProbe& probe) const {
+    // Texture OpenGL retournée verticalement : hauteur source négative
+    Rectangle source = {0.0f, 0.0f,
+                        static_cast<float>(this->target_.texture.width),
+                        -static_cast<float>(this->target_.texture.height)};
+    // Chaque changement de mode de fusion envoie le lot en cours
+    if (probe) probe(true);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(this->target_.texture, source,
+                   {this->bounds_.x, this->bounds_.y}, WHITE);
+    if (probe) probe(true);
+    EndBlendMode();
+}
+
+bool CachedLayer::needsContent(Rectangle bounds, uint64_t key) noexcept {
+    bool stale = this->stale_.exchange(false);
+    bool same = key == this->recordedKey_ &&
+                std::memcmp(&bounds, &this->recordedBounds_,
+                            sizeof(bounds)) == 0;
+    if (same && !stale) return false;
+    this->recordedBounds_ = bounds;
+    this->recordedKey_ = key;
+    return true;
+}
+
+void CachedLayer::release() {
+    if (this->target_.id != 0) UnloadRenderTexture(this->target_);
+    this->target_ = {};
+    this->invalidate();
+}
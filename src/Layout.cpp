@@ -0,0 +1,172 @@
+#include "Layout.hpp"
+#include <algorithm>
+
+namespace {
+constexpr size_t MAX_PROFILES{4};
+constexpr float CARD_W{180.0f};
+constexpr float CARD_H{220.0f};
+constexpr float CARD_STEP{200.0f}; ///< Largeur de carte et espacement
+constexpr float SCALE_STEP{70.0f};
+constexpr float MODE_STEP{80.0f};
+constexpr float GAME_STEP{100.0f};
+
+/**
+ * @brief Teste l'appartenance d'un point à un rectangle
+ * @return `true` si le point est dans le rectangle, bords inclus
+ */
+bool contains(const Rectangle& rect, Vector2 point) {
+    return point.x >= rect.x && point.x <= rect.x + rect.width &&
+           point.y >= rect.y && point.y <= rect.y + rect.height;
+}
+} // namespace
+
+void Layout::place(Widget widget, int32_t index, Rectangle rect) {
+    auto& first = this->first_[static_cast<size_t>(widget)];
+    if (first < 0) first = static_cast<int32_t>(this->placed_.size());
+    this->placed_.push_back({widget, index, rect});
+}
+
+void Layout::placeProfileSelect() {
+    float w = this->inputs_.screenW;
+    float h = this->inputs_.screenH;
+    size_t count = this->inputs_.profiles;
+    bool canAdd = count < MAX_PROFILES;
+    float totalW = static_cast<float>(count) * CARD_STEP +
+                   (canAdd ? CARD_STEP : 0.0f) - (CARD_STEP - CARD_W);
+    float startX = w / 2.0f - totalW / 2.0f;
+    float top = h / 2.0f - CARD_H / 2.0f;
+
+    for (size_t i = 0; i < count; ++i) {
+        this->place(Widget::PROFILE_CARD, static_cast<int32_t>(i),
+                    {startX + static_cast<float>(i) * CARD_STEP, top, CARD_W,
+                     CARD_H});
+    }
+    // Suppression au-dessus de sa carte
+    for (size_t i = 0; i < count; ++i) {
+        Rectangle card = this->placed_[i].rect;
+        this->place(Widget::PROFILE_DELETE, static_cast<int32_t>(i),
+                    {card.x + 150.0f, card.y + 5.0f, 25.0f, 25.0f});
+    }
+    if (canAdd) {
+        this->place(Widget::PROFILE_ADD, 0,
+                    {startX + static_cast<float>(count) * CARD_STEP, top,
+                     CARD_W, CARD_H});
+    }
+}
+
+void Layout::placeMenu() {
+    float w = this->inputs_.screenW;
+    float h = this->inputs_.screenH;
+    for (size_t i = 0; i < this->inputs_.games; ++i) {
+        this->place(Widget::MENU_GAME, static_cast<int32_t>(i),
+                    {w / 2.0f - 250.0f,
+                     h * 0.3f + static_cast<float>(i) * GAME_STEP, 500.0f,
+                     80.0f});
+    }
+    float scaleStartX = w / 2.0f - (7.0f * SCALE_STEP) / 2.0f;
+    for (int32_t i = 0; i < 7; ++i) {
+        this->place(Widget::MENU_SCALE, i,
+                    {scaleStartX + static_cast<float>(i) * SCALE_STEP,
+                     h * 0.75f, 60.0f, 40.0f});
+    }
+    for (int32_t i = 0; i < 2; ++i) {
+        this->place(Widget::MENU_MODE, i,
+                    {w / 2.0f - 75.0f + static_cast<float>(i) * MODE_STEP,
+                     h * 0.85f, 70.0f, 40.0f});
+    }
+    this->place(Widget::MENU_SWITCH_USER, 0,
+                {w / 2.0f - 150.0f, h * 0.92f, 300.0f, 30.0f});
+    this->place(Widget::MENU_KEYBOARD, 0, {40.0f, h - 80.0f, 250.0f, 40.0f});
+    this->place(Widget::MENU_FALLING, 0, {40.0f, h - 130.0f, 220.0f, 40.0f});
+    this->place(Widget::MENU_NOTATION, 0,
+                {w - 290.0f, h - 80.0f, 250.0f, 40.0f});
+}
+
+void Layout::placePlay() {
+    float w = this->inputs_.screenW;
+    float h = this->inputs_.screenH;
+    this->place(Widget::PLAY_PAUSE, 0, {w - 85.0f, 25.0f, 60.0f, 60.0f});
+    if (!this->inputs_.paused) {
+        this->place(Widget::PLAY_MENU, 0, {25.0f, 25.0f, 120.0f, 45.0f});
+        this->place(Widget::PLAY_NEXT, 0, {160.0f, 25.0f, 160.0f, 45.0f});
+        return;
+    }
+    // Boutons de pause au-dessus de leur cadre
+    this->place(Widget::PAUSE_PANEL, 0,
+                {w / 2.0f - 200.0f, h / 2.0f - 150.0f, 400.0f, 300.0f});
+    this->place(Widget::PAUSE_RESUME, 0,
+                {w / 2.0f - 150.0f, h / 2.0f - 50.0f, 300.0f, 60.0f});
+    this->place(Widget::PAUSE_QUIT, 0,
+                {w / 2.0f - 150.0f, h / 2.0f + 30.0f, 300.0f, 60.0f});
+}
+
+void Layout::placeGameOver() {
+    float w = this->inputs_.screenW;
+    float h = this->inputs_.screenH;
+    this->place(Widget::GAME_OVER_BACK, 0,
+                {w / 2.0f - 150.0f, h * 0.7f, 300.0f, 55.0f});
+}
+
+int32_t Layout::cellOf(float value, float extent) {
+    if (extent <= 0.0f) return 0;
+    auto cell = static_cast<int32_t>(value / extent * GRID);
+    return std::clamp(cell, 0, GRID - 1);
+}
+
+void Layout::buildIndex() {
+    for (auto& cell : this->cells_) cell.clear();
+    float w = this->inputs_.screenW;
+    float h = this->inputs_.screenH;
+    for (size_t i = 0; i < this->placed_.size(); ++i) {
+        const Rectangle& r = this->placed_[i].rect;
+        for (int32_t cy = cellOf(r.y, h); cy <= cellOf(r.y + r.height, h);
+             ++cy) {
+            for (int32_t cx = cellOf(r.x, w); cx <= cellOf(r.x + r.width, w);
+                 ++cx) {
+                this->cells_[static_cast<size_t>(cy * GRID + cx)].push_back(
+                    static_cast<uint16_t>(i));
+            }
+        }
+    }
+}
+
+bool Layout::update(const LayoutInputs& inputs) {
+    if (this->built_ && inputs == this->inputs_) return false;
+    this->inputs_ = inputs;
+    this->built_ = true;
+    this->placed_.clear();
+    this->first_.fill(-1);
+    switch (inputs.state) {
+    case AppState::PROFILE_SELECT: this->placeProfileSelect(); break;
+    case AppState::MENU: this->placeMenu(); break;
+    case AppState::PLAY: this->placePlay(); break;
+    case AppState::GAME_OVER: this->placeGameOver(); break;
+    }
+    this->buildIndex();
+    this->hover_ = {};
+    return true;
+}
+
+Rectangle Layout::rect(Widget widget, int32_t index) const {
+    int32_t first = this->first_[static_cast<size_t>(widget)];
+    if (first < 0 || index < 0) return {};
+    auto pos = static_cast<size_t>(first + index);
+    if (pos >= this->placed_.size() || this->placed_[pos].widget != widget) {
+        return {};
+    }
+    return this->placed_[pos].rect;
+}
+
+Hit Layout::hitTest(Vector2 point) const {
+    if (!this->built_) return {};
+    const auto& cell =
+        this->cells_[static_cast<size_t>(
+            cellOf(point.y, this->inputs_.screenH) * GRID +
+            cellOf(point.x, this->inputs_.screenW))];
+    // Indices croissants dans la cellule : le dernier trouvé est au-dessus
+    for (auto it = cell.rbegin(); it != cell.rend(); ++it) {
+        const Placed& p = this->placed_[*it];
+        if (contains(p.rect, point)) return {p.widget, p.index};
+    }
+    return {};
+}
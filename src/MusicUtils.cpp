@@ -1,21 +1,121 @@
 #include "MusicUtils.hpp"
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <sstream>
 
 namespace MusicUtils {
 
-std::vector<std::string> splitNotes(const std::string& s) {
-    std::vector<std::string> notes;
-    std::istringstream iss(s);
-    std::string tok;
-    while (iss >> tok) {
-        notes.push_back(tok);
+namespace {
+/// Notes des gammes proposées, indexées par mode puis par tonique
+constexpr std::array<std::array<std::array<std::string_view, 7>, 7>, 2>
+    SCALE_NOTES{{
+        {{{"c", "d", "e", "f", "g", "a", "b"},
+          {"d", "e", "f#", "g", "a", "b", "c#"},
+          {"e", "f#", "g#", "a", "b", "c#", "d#"},
+          {"f", "g", "a", "bb", "c", "d", "e"},
+          {"g", "a", "b", "c", "d", "e", "f#"},
+          {"a", "b", "c#", "d", "e", "f#", "g#"},
+          {"b", "c#", "d#", "e", "f#", "g#", "a#"}}},
+        {{{"c", "d", "eb", "f", "g", "ab", "bb"},
+          {"d", "e", "f", "g", "a", "bb", "c"},
+          {"e", "f#", "g", "a", "b", "c", "d"},
+          {"f", "g", "ab", "bb", "c", "db", "eb"},
+          {"g", "a", "bb", "c", "d", "eb", "f"},
+          {"a", "b", "c", "d", "e", "f", "g"},
+          {"b", "c#", "d", "e", "f#", "g", "a"}}},
+    }};
+
+/// Orthographe chromatique par défaut, en dièses puis en bémols
+constexpr ScaleSpelling SHARP_SPELLING{"c",  "c#", "d",  "d#", "e",  "f",
+                                       "f#", "g",  "g#", "a",  "a#", "b"};
+constexpr ScaleSpelling FLAT_SPELLING{"c",  "db", "d",  "eb", "e",  "f",
+                                      "gb", "g",  "ab", "a",  "bb", "b"};
+
+/// Sensibles et sixtes haussées du mineur (do# en ré mineur…)
+constexpr std::array<std::array<std::string_view, 2>, 7> MINOR_RAISED{{
+    {"a", "b"},
+    {"b", "c#"},
+    {"c#", "d#"},
+    {"d", "e"},
+    {"e", "f#"},
+    {"f#", "g#"},
+    {"g#", "a#"},
+}};
+
+/// Classe de hauteur des notes naturelles, indexée par lettre depuis 'a'
+constexpr std::array<int32_t, 7> LETTER_PITCH{9, 11, 0, 2, 4, 5, 7};
+
+constexpr size_t scaleIndex(ScaleChoice scale) {
+    return static_cast<size_t>(scale) % 7;
+}
+
+constexpr size_t modeIndex(ModeChoice mode) {
+    return mode == ModeChoice::MODE_MAJ ? 0 : 1;
+}
+
+/// Note décomposée : lettre, altération cumulée et éventuelle octave
+struct ParsedNote {
+    int32_t letterPitch{-1}; ///< Classe de hauteur de la lettre seule
+    int32_t alteration{0};   ///< Demi-tons ajoutés (#, x) ou retirés (b)
+    int32_t octave{-1};      ///< Octave, -1 si absente
+};
+
+/**
+ * @brief Décompose une note textuelle (lettre, altérations, octave)
+ * @param note Note à décomposer (ex: "c#4", "fbb", "e#5", "gx3")
+ * @return Note décomposée, `letterPitch` à -1 si invalide
+ */
+ParsedNote parseNote(std::string_view note) {
+    if (note.empty()) return {};
+    auto letter = static_cast<char>(
+        std::tolower(static_cast<unsigned char>(note.front())));
+    if (letter < 'a' || letter > 'g') return {};
+    ParsedNote parsed{LETTER_PITCH[static_cast<size_t>(letter - 'a')]};
+    size_t i = 1;
+    for (; i < note.size(); ++i) {
+        if (note[i] == '#') parsed.alteration += 1;
+        else if (note[i] == 'x') parsed.alteration += 2;
+        else if (note[i] == 'b') parsed.alteration -= 1;
+        else break;
     }
-    return notes;
+    if (i < note.size()) {
+        if (!std::isdigit(static_cast<unsigned char>(note[i]))) return {};
+        parsed.octave = note[i] - '0';
+    }
+    return parsed;
 }
 
-std::string noteLetterToFrench(char c) {
+/**
+ * @brief Précalcule l'orthographe des 12 classes de hauteur d'une gamme
+ * @param scale Tonique de la gamme
+ * @param mode Mode de la gamme
+ * @return Orthographe indexée par classe de hauteur (do=0)
+ */
+ScaleSpelling buildSpelling(size_t scale, size_t mode) {
+    const auto& degrees = SCALE_NOTES[mode][scale];
+    // Notes hors gamme : bémols si armure bémolisée, dièses sinon
+    bool flats = std::ranges::any_of(degrees, [](std::string_view n) {
+        return n.size() > 1 && n[1] == 'b';
+    });
+    ScaleSpelling spelling = flats ? FLAT_SPELLING : SHARP_SPELLING;
+    if (mode == 1) {
+        for (std::string_view raised : MINOR_RAISED[scale]) {
+            spelling[static_cast<size_t>(pitchClass(raised))] = raised;
+        }
+    }
+    for (std::string_view degree : degrees) {
+        spelling[static_cast<size_t>(pitchClass(degree))] = degree;
+    }
+    return spelling;
+}
+
+/**
+ * @brief Nom français d'une lettre de note
+ * @param c Lettre, minuscule ou majuscule
+ * @return Nom (DO à SI), vide si la lettre est invalide
+ */
+std::string_view frenchLetter(char c) {
     switch (std::tolower(static_cast<unsigned char>(c))) {
     case 'c': return "DO";
     case 'd': return "RE";
@@ -24,37 +124,80 @@ std::string noteLetterToFrench(char c) {
     case 'g': return "SOL";
     case 'a': return "LA";
     case 'b': return "SI";
-    default: return std::string(1, c);
+    default: return {};
     }
 }
 
-std::string noteDisplayLabel(const std::string& note, NotationMode mode) {
-    if (note.empty()) return note;
+/**
+ * @brief Écrit le libellé d'une note à la suite d'une chaîne, quelle que
+ * soit son allocation
+ * @param label Chaîne complétée
+ * @param note Note textuelle
+ * @param mode Mode de notation
+ */
+template <typename String>
+void appendDisplayLabel(String& label, std::string_view note,
+                        NotationMode mode) {
+    if (note.empty()) return;
     if (mode == NotationMode::LETTER) {
-        std::string label;
         label += static_cast<char>(
             std::toupper(static_cast<unsigned char>(note[0])));
-        size_t i = 1;
-        if (i < note.size() && (note[i] == '#' || note[i] == 'b')) {
-            label += note[i];
-            ++i;
-        }
-        if (i < note.size()) {
-            label += " " + note.substr(i);
-        }
-        return label;
+    } else if (std::string_view french = frenchLetter(note[0]);
+               !french.empty()) {
+        label += french;
     } else {
-        std::string label = noteLetterToFrench(note[0]);
-        size_t i = 1;
-        if (i < note.size() && (note[i] == '#' || note[i] == 'b')) {
-            label += (note[i] == '#') ? "#" : "b";
-            ++i;
-        }
-        if (i < note.size()) {
-            label += " " + note.substr(i);
-        }
-        return label;
+        label += note[0];
+    }
+    size_t i = 1;
+    if (i < note.size() && (note[i] == '#' || note[i] == 'b')) {
+        label += note[i];
+        ++i;
+    }
+    if (i < note.size()) {
+        label += ' ';
+        label += note.substr(i);
+    }
+}
+
+/**
+ * @brief Lettre et altération simple d'une note, octave exclue
+ * @param note Note textuelle
+ * @return Préfixe de `note`
+ */
+std::string_view noteBaseOf(std::string_view note) {
+    if (note.size() > 1 && (note[1] == '#' || note[1] == 'b')) {
+        return note.substr(0, 2);
     }
+    return note.substr(0, 1);
+}
+} // namespace
+
+std::vector<std::string> splitNotes(const std::string& s) {
+    std::vector<std::string> notes;
+    std::istringstream iss(s);
+    std::string tok;
+    while (iss >> tok) {
+        notes.push_back(tok);
+    }
+    return notes;
+}
+
+std::string noteLetterToFrench(char c) {
+    std::string_view french = frenchLetter(c);
+    return french.empty() ? std::string(1, c) : std::string(french);
+}
+
+std::string noteDisplayLabel(const std::string& note, NotationMode mode) {
+    std::string label;
+    appendDisplayLabel(label, note, mode);
+    return label;
+}
+
+std::pmr::string noteDisplayLabel(std::string_view note, NotationMode mode,
+                                  std::pmr::memory_resource* resource) {
+    std::pmr::string label(resource);
+    appendDisplayLabel(label, note, mode);
+    return label;
 }
 
 std::string chordDisplayLabel(const std::string& chordName, NotationMode mode) {
@@ -95,32 +238,19 @@ std::string getNotationLabel(int32_t whiteIdx, NotationMode mode) {
 }
 
 std::vector<std::string> getScaleNotesList(ScaleChoice scale, ModeChoice mode) {
-    int s = static_cast<int>(scale);
-    bool isMaj = (mode == ModeChoice::MODE_MAJ);
-    if (isMaj) {
-        switch (s) {
-        case 0: return {"c", "d", "e", "f", "g", "a", "b"};
-        case 1: return {"d", "e", "f#", "g", "a", "b", "c#"};
-        case 2: return {"e", "f#", "g#", "a", "b", "c#", "d#"};
-        case 3: return {"f", "g", "a", "bb", "c", "d", "e"};
-        case 4: return {"g", "a", "b", "c", "d", "e", "f#"};
-        case 5: return {"a", "b", "c#", "d", "e", "f#", "g#"};
-        case 6: return {"b", "c#", "d#", "e", "f#", "g#", "a#"};
-        default: break;
-        }
-    } else {
-        switch (s) {
-        case 0: return {"c", "d", "eb", "f", "g", "ab", "bb"};
-        case 1: return {"d", "e", "f", "g", "a", "bb", "c"};
-        case 2: return {"e", "f#", "g", "a", "b", "c", "d"};
-        case 3: return {"f", "g", "ab", "bb", "c", "db", "eb"};
-        case 4: return {"g", "a", "bb", "c", "d", "eb", "f"};
-        case 5: return {"a", "b", "c", "d", "e", "f", "g"};
-        case 6: return {"b", "c#", "d", "e", "f#", "g", "a"};
-        default: break;
-        }
-    }
-    return {};
+    const auto& notes = SCALE_NOTES[modeIndex(mode)][scaleIndex(scale)];
+    return {notes.begin(), notes.end()};
+}
+
+std::pmr::vector<std::pmr::string>
+getScaleNotesList(ScaleChoice scale, ModeChoice mode,
+                  std::pmr::memory_resource* resource) {
+    const auto& notes = SCALE_NOTES[modeIndex(mode)][scaleIndex(scale)];
+    // Allocateur transmis aux notes par le vecteur
+    std::pmr::vector<std::pmr::string> list(resource);
+    list.reserve(notes.size());
+    for (std::string_view note : notes) list.emplace_back(note);
+    return list;
 }
 
 std::string getScaleNameFormatted(ScaleChoice scale, ModeChoice mode,
@@ -135,11 +265,76 @@ std::string getScaleNameFormatted(ScaleChoice scale, ModeChoice mode,
     return name;
 }
 
+int32_t pitchClass(std::string_view note) {
+    ParsedNote parsed = parseNote(note);
+    if (parsed.letterPitch < 0) return -1;
+    return ((parsed.letterPitch + parsed.alteration) % 12 + 12) % 12;
+}
+
+int32_t midiNumber(std::string_view note) {
+    ParsedNote parsed = parseNote(note);
+    if (parsed.letterPitch < 0) return -1;
+    int32_t octave = parsed.octave < 0 ? 4 : parsed.octave;
+    return (octave + 1) * 12 + parsed.letterPitch + parsed.alteration;
+}
+
+const ScaleSpelling& getScaleSpelling(ScaleChoice scale, ModeChoice mode) {
+    static const auto TABLE = [] {
+        std::array<std::array<ScaleSpelling, 7>, 2> table{};
+        for (size_t m = 0; m < table.size(); ++m) {
+            for (size_t s = 0; s < table[m].size(); ++s) {
+                table[m][s] = buildSpelling(s, m);
+            }
+        }
+        return table;
+    }();
+    return TABLE[modeIndex(mode)][scaleIndex(scale)];
+}
+
+std::string spellNote(std::string_view note, ScaleChoice scale,
+                      ModeChoice mode) {
+    ParsedNote parsed = parseNote(note);
+    if (parsed.letterPitch < 0) return std::string(note);
+    int32_t pitch = parsed.letterPitch + parsed.alteration;
+    std::string_view spelled =
+        getScaleSpelling(scale, mode)[static_cast<size_t>((pitch % 12 + 12) %
+                                                          12)];
+    std::string result(spelled);
+    if (parsed.octave < 0) return result;
+    // Octave recalculée depuis la hauteur absolue (ex: "b#3" → "c4")
+    ParsedNote target = parseNote(spelled);
+    int32_t midi = (parsed.octave + 1) * 12 + pitch;
+    int32_t targetPitch = target.letterPitch + target.alteration;
+    int32_t octave = (midi - targetPitch) / 12 - 1;
+    if (octave < 0) return std::string(note); // Hors clavier (ex: "cb0")
+    result += std::to_string(octave);
+    return result;
+}
+
+std::string noteName(int32_t midi, ScaleChoice scale, ModeChoice mode) {
+    static constexpr std::array<std::string_view, 12> SHARPS{
+        "c", "c#", "d", "d#", "e", "f", "f#", "g", "g#", "a", "a#", "b"};
+    if (midi < 12 || midi >= 132) return {};
+    std::string sharp(SHARPS[static_cast<size_t>(midi % 12)]);
+    sharp += static_cast<char>('0' + midi / 12 - 1);
+    return spellNote(sharp, scale, mode);
+}
+
+std::vector<std::string> spellNotes(const std::vector<std::string>& notes,
+                                    ScaleChoice scale, ModeChoice mode) {
+    std::vector<std::string> spelled;
+    spelled.reserve(notes.size());
+    for (const auto& note : notes) {
+        spelled.push_back(spellNote(note, scale, mode));
+    }
+    return spelled;
+}
+
 NoteKey resolveKey(const std::string& note, int32_t baseKeyboardOctave) {
     if (note.empty()) return {};
     char letter = note[0];
     size_t i = 1;
-    std::string mod;
+    char mod = '\0';
     if (i < note.size() && (note[i] == '#' || note[i] == 'b')) {
         mod = note[i];
         ++i;
@@ -164,12 +359,12 @@ NoteKey resolveKey(const std::string& note, int32_t baseKeyboardOctave) {
         whiteIdx -= octaveOffset * 7;
     }
 
-    if (mod.empty()) {
+    if (mod == '\0') {
         return {false, whiteIdx + octaveOffset * 7, true};
     }
 
     int32_t bkWhiteIdx = whiteIdx;
-    if (mod == "b") {
+    if (mod == 'b') {
         bkWhiteIdx -= 1;
         // handle underflow for negative bkWhiteIdx if needed
         if (bkWhiteIdx < 0) {
@@ -204,36 +399,31 @@ int32_t getChallengeBaseOctave(const std::vector<std::string>& expectedNotes) {
     return minOctave;
 }
 
-bool isSameNoteClass(const std::string& a, const std::string& b) {
-    auto clean = [](const std::string& s) {
-        std::string r;
-        for (char c : s) {
-            if (!std::isdigit(static_cast<unsigned char>(c))) {
-                r += static_cast<char>(
-                    std::tolower(static_cast<unsigned char>(c)));
-            }
-        }
-        return r;
+bool isSameNoteClass(std::string_view a, std::string_view b) {
+    // Comparaison au fil des deux chaînes, chiffres sautés, sans copie
+    auto isDigit = [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c)) != 0;
+    };
+    auto lower = [](char c) {
+        return std::tolower(static_cast<unsigned char>(c));
     };
-    return clean(a) == clean(b);
+    size_t i = 0;
+    size_t j = 0;
+    while (true) {
+        while (i < a.size() && isDigit(a[i])) ++i;
+        while (j < b.size() && isDigit(b[j])) ++j;
+        if (i == a.size() || j == b.size()) {
+            return i == a.size() && j == b.size();
+        }
+        if (lower(a[i++]) != lower(b[j++])) return false;
+    }
 }
 
-bool noteInList(const std::string& noteBase,
+bool noteInList(std::string_view noteBase,
                 const std::vector<std::string>& list) {
-    auto strip = [](const std::string& n) {
-        if (n.empty()) return n;
-        std::string s;
-        s += n[0];
-        if (n.size() > 1 && (n[1] == '#' || n[1] == 'b')) {
-            s += n[1];
-        }
-        return s;
-    };
-    std::string base = strip(noteBase);
-    for (const auto& n : list) {
-        if (strip(n) == base) return true;
-    }
-    return false;
+    std::string_view base = noteBaseOf(noteBase);
+    return std::ranges::any_of(
+        list, [&](const std::string& n) { return noteBaseOf(n) == base; });
 }
 
 } // namespace MusicUtils
@@ -0,0 +1,98 @@
+#include "PianoKeymap.hpp"
+#include "raylib.h"
+#include <array>
+
+namespace {
+/// Touche jouable : position, hauteur et lettres gravées
+struct KeymapEntry {
+    int32_t key;   ///< Code raylib (position sur un clavier QWERTY)
+    int8_t offset; ///< Demi-tons au-dessus du do de départ
+    char qwerty;   ///< Lettre sur un clavier QWERTY
+    char azerty;   ///< Lettre sur un clavier AZERTY
+};
+
+/// Rangée des lettres du haut d'abord : elle l'emporte pour les lettres
+/// affichées là où les deux rangées se recouvrent
+constexpr std::array<KeymapEntry, PianoKeymap::SLOTS> KEYMAP{{
+    // Rangée des lettres du haut et chiffres : deuxième octave
+    {KEY_Q, 12, 'Q', 'A'},
+    {KEY_TWO, 13, '2', '2'},
+    {KEY_W, 14, 'W', 'Z'},
+    {KEY_THREE, 15, '3', '3'},
+    {KEY_E, 16, 'E', 'E'},
+    {KEY_R, 17, 'R', 'R'},
+    {KEY_FIVE, 18, '5', '5'},
+    {KEY_T, 19, 'T', 'T'},
+    {KEY_SIX, 20, '6', '6'},
+    {KEY_Y, 21, 'Y', 'Y'},
+    {KEY_SEVEN, 22, '7', '7'},
+    {KEY_U, 23, 'U', 'U'},
+    {KEY_I, 24, 'I', 'I'},
+    {KEY_NINE, 25, '9', '9'},
+    {KEY_O, 26, 'O', 'O'},
+    {KEY_ZERO, 27, '0', '0'},
+    {KEY_P, 28, 'P', 'P'},
+    // Rangée du bas et rangée du milieu : première octave
+    {KEY_Z, 0, 'Z', 'W'},
+    {KEY_S, 1, 'S', 'S'},
+    {KEY_X, 2, 'X', 'X'},
+    {KEY_D, 3, 'D', 'D'},
+    {KEY_C, 4, 'C', 'C'},
+    {KEY_V, 5, 'V', 'V'},
+    {KEY_G, 6, 'G', 'G'},
+    {KEY_B, 7, 'B', 'B'},
+    {KEY_H, 8, 'H', 'H'},
+    {KEY_N, 9, 'N', 'N'},
+    {KEY_J, 10, 'J', 'J'},
+    {KEY_M, 11, 'M', ','},
+    {KEY_COMMA, 12, ',', ';'},
+    {KEY_L, 13, 'L', 'L'},
+    {KEY_PERIOD, 14, '.', ':'},
+    {KEY_SEMICOLON, 15, ';', 'M'},
+    {KEY_SLASH, 16, '/', '!'},
+}};
+
+/// Emplacement de chaque code de touche, calculé à la compilation
+constexpr std::array<int8_t, PianoKeymap::CODES> buildIndex() {
+    std::array<int8_t, PianoKeymap::CODES> index{};
+    index.fill(-1);
+    for (size_t i = 0; i < KEYMAP.size(); ++i) {
+        index[static_cast<size_t>(KEYMAP[i].key)] = static_cast<int8_t>(i);
+    }
+    return index;
+}
+
+constexpr std::array<int8_t, PianoKeymap::CODES> INDEX{buildIndex()};
+} // namespace
+
+bool PianoKeymap::parse(std::string_view name, KeyLayout& layout) {
+    if (name == "qwerty") {
+        layout = KeyLayout::QWERTY;
+    } else if (name == "azerty") {
+        layout = KeyLayout::AZERTY;
+    } else if (name == "none") {
+        layout = KeyLayout::NONE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int32_t PianoKeymap::slotOf(int32_t key) const noexcept {
+    if (!this->enabled() || key < 0 || key >= CODES) return -1;
+    return INDEX[static_cast<size_t>(key)];
+}
+
+int32_t PianoKeymap::offset(int32_t slot) noexcept {
+    return KEYMAP[static_cast<size_t>(slot)].offset;
+}
+
+char PianoKeymap::label(int32_t slot) const noexcept {
+    const KeymapEntry& key = KEYMAP[static_cast<size_t>(slot)];
+    switch (this->layout_) {
+    case KeyLayout::QWERTY: return key.qwerty;
+    case KeyLayout::AZERTY: return key.azerty;
+    case KeyLayout::NONE: break;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "PlayViewModel.hpp"
+#include "MusicUtils.hpp"
+#include <algorithm>
+#include <format>
+
+using namespace Colors;
+
+namespace {
+constexpr float BOX_W{50.0f};
+constexpr float BOX_H{40.0f};
+constexpr float BOX_SPACING{12.0f};
+
+/**
+ * @brief Masque des classes de hauteur d'une liste de notes
+ * @param notes Notes (ex : "c4", "eb4")
+ * @return Bit n posé si une note est de classe n
+ */
+uint16_t pitchMask(const std::vector<std::string>& notes) {
+    uint16_t mask = 0;
+    for (const auto& n : notes) {
+        int32_t pc = MusicUtils::pitchClass(n);
+        if (pc >= 0) mask |= static_cast<uint16_t>(1U << pc);
+    }
+    return mask;
+}
+} // namespace
+
+void PlayViewModel::layout() {
+    if (this->screenW_ <= 0.0f) return;
+    float midX = this->screenW_ / 2.0f;
+    this->challengeRect_ = {midX - 175.0f, this->screenH_ * 0.25f, 350.0f,
+                            200.0f};
+    const Rectangle& rChal = this->challengeRect_;
+
+    this->showStaff_ = this->notation_ == NotationMode::STAFF &&
+                       !this->staffNotes_.empty();
+    this->challengeTextSize_ = (this->challengeText_.size() > 8) ? 28 : 36;
+    this->challengeTextPos_ = {midX, rChal.y + 80.0f};
+
+    this->scaleTitle_ = "Gamme active : " +
+                        MusicUtils::getScaleNameFormatted(
+                            this->scale_, this->mode_, this->notation_);
+    this->scaleTitlePos_ = {midX, rChal.y + rChal.height + 15.0f};
+
+    auto notes = MusicUtils::getScaleNotesList(this->scale_, this->mode_);
+    this->boxCount_ = std::min(notes.size(), MAX_BOXES);
+    float startX = midX - (7.0f * BOX_W + 6.0f * BOX_SPACING) / 2.0f;
+    float startY = rChal.y + rChal.height + 42.0f;
+    for (size_t i = 0; i < this->boxCount_; ++i) {
+        Rectangle box = {startX + static_cast<float>(i) * (BOX_W + BOX_SPACING),
+                         startY, BOX_W, BOX_H};
+        this->boxRect_[i] = box;
+        this->boxPitch_[i] = MusicUtils::pitchClass(notes[i]);
+        this->boxLabel_[i] =
+            MusicUtils::noteDisplayLabel(notes[i], this->notation_);
+        int32_t size = (this->boxLabel_[i].size() > 2) ? 14 : 18;
+        this->boxFontSize_[i] = size;
+        this->boxLabelPos_[i] = {
+            box.x + box.width / 2,
+            box.y + box.height / 2 - static_cast<float>(size / 2)};
+    }
+
+    this->scorePos_ = {midX - 20.0f, 45.0f};
+    this->feedbackPos_ = {midX, this->screenH_ * 0.2f};
+}
+
+void PlayViewModel::recolor() {
+    for (size_t i = 0; i < this->boxCount_; ++i) {
+        int32_t pc = this->boxPitch_[i];
+        auto has = [pc](uint16_t mask) {
+            return pc >= 0 && (mask & (1U << pc)) != 0;
+        };
+        bool hov = this->hoverBox_ == static_cast<int32_t>(i);
+        Color accent = has(this->wrongMask_)      ? kRougeErreur
+                       : has(this->correctMask_)  ? kVertEclatant
+                       : has(this->expectedMask_) ? kOrangeNote
+                       : has(this->pressedMask_)  ? this->userColor_
+                                                  : BLANK;
+        if (accent.a != 0) {
+            this->boxFill_[i] = Fade(accent, 0.4f);
+            this->boxBorder_[i] = accent;
+            this->boxText_[i] = WHITE;
+        } else {
+            this->boxFill_[i] = Fade(kVertEclatant, hov ? 0.15f : 0.05f);
+            this->boxBorder_[i] = hov ? WHITE : Fade(kVertEclatant, 0.3f);
+            this->boxText_[i] = hov ? WHITE : Fade(kVertEclatant, 0.7f);
+        }
+        this->boxLineWidth_[i] = hov ? 3.0f : 2.0f;
+    }
+}
+
+void PlayViewModel::setLayout(float screenW, float screenH) {
+    if (screenW == this->screenW_ && screenH == this->screenH_) return;
+    this->screenW_ = screenW;
+    this->screenH_ = screenH;
+    this->layout();
+    this->recolor();
+}
+
+void PlayViewModel::setSettings(ScaleChoice scale, ModeChoice mode,
+                                NotationMode notation, Color userColor) {
+    this->scale_ = scale;
+    this->mode_ = mode;
+    this->notation_ = notation;
+    this->userColor_ = userColor;
+    this->layout();
+    this->recolor();
+}
+
+void PlayViewModel::setChallenge(const Challenge& challenge) {
+    this->staffNotes_ = challenge.expectedNotes;
+    this->challengeText_ =
+        challenge.expectedNotes.empty() ? "Attente…" : challenge.displayText;
+    this->expectedMask_ = pitchMask(challenge.expectedNotes);
+    this->layout();
+    this->recolor();
+}
+
+void PlayViewModel::setResult(const ChallengeResult& result) {
+    this->correctMask_ = result.active ? pitchMask(result.correct) : 0;
+    this->wrongMask_ = result.active ? pitchMask(result.incorrect) : 0;
+    this->recolor();
+}
+
+void PlayViewModel::setScore(int32_t score, const char* feedback) {
+    if (score != this->score_) {
+        this->score_ = score;
+        this->scoreText_ = std::format("{}", score);
+    }
+    this->feedback_ = feedback;
+}
+
+void PlayViewModel::setPointer(Vector2 mouse, uint16_t pressedPitchClasses) {
+    int32_t hoverBox = -1;
+    for (size_t i = 0; i < this->boxCount_; ++i) {
+        if (CheckCollisionPointRec(mouse, this->boxRect_[i])) {
+            hoverBox = static_cast<int32_t>(i);
+            break;
+        }
+    }
+    if (hoverBox == this->hoverBox_ &&
+        pressedPitchClasses == this->pressedMask_) {
+        return;
+    }
+    this->hoverBox_ = hoverBox;
+    this->pressedMask_ = pressedPitchClasses;
+    this->recolor();
+}
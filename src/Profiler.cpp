@@ -0,0 +1,115 @@
+#include "Profiler.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <span>
+
+namespace {
+/**
+ * @brief Millisecondes écoulées depuis un instant
+ * @return Durée en millisecondes
+ */
+float msSince(FrameProfiler::Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(
+               FrameProfiler::Clock::now() - start)
+        .count();
+}
+} // namespace
+
+void FrameProfiler::add(FrameSection section, Clock::time_point start,
+                        uint64_t allocations) {
+    auto k = static_cast<size_t>(section);
+    this->current_.sectionMs[k] += msSince(start);
+    this->current_.sectionAllocs[k] += static_cast<uint32_t>(allocations);
+}
+
+void FrameProfiler::beginFrame() {
+    this->current_ = {};
+    this->frameStart_ = Clock::now();
+    this->allocStart_ = AllocCounter::threadCount();
+}
+
+void FrameProfiler::endFrame() {
+    this->current_.totalMs = msSince(this->frameStart_);
+    this->current_.allocations = static_cast<uint32_t>(
+        AllocCounter::threadCount() - this->allocStart_);
+    this->history_[this->next_] = this->current_;
+    this->next_ = (this->next_ + 1) % HISTORY;
+    this->count_ = std::min(this->count_ + 1, HISTORY);
+    ++this->frames_;
+    if (this->visible_) this->summarize();
+
+    // Journal hors de la mesure : l'image suivante repart de `beginFrame`.
+    // L'enregistrement peut tourner sur son thread, hors de `allocations`
+    const auto& sections = this->current_.sectionAllocs;
+    uint32_t draw = sections[static_cast<size_t>(FrameSection::DRAW)];
+    if (AllocCounter::AUDIT && (this->current_.allocations > 0 || draw > 0)) {
+        Logger::log("[Audit] Image {} : {} allocations (messages {}, logique "
+                    "{}, rendu {}, présentation {})",
+                    this->frames_, this->current_.allocations, sections[0],
+                    sections[1], draw, sections[3]);
+    }
+}
+
+void FrameProfiler::countMessages(size_t processed, size_t queueDepth) {
+    this->queueDepth_ = queueDepth;
+    this->messages_ += static_cast<uint32_t>(processed);
+    auto now = Clock::now();
+    if (now - this->rateStart_ < std::chrono::seconds(1)) return;
+    if (this->rateStart_ != Clock::time_point{}) {
+        float elapsed =
+            std::chrono::duration<float>(now - this->rateStart_).count();
+        this->messagesPerSecond_ = static_cast<uint32_t>(
+            static_cast<float>(this->messages_) / elapsed);
+    }
+    this->messages_ = 0;
+    this->rateStart_ = now;
+}
+
+void FrameProfiler::addInputLatency(double seconds) {
+    this->latencyMs_[this->latencyNext_] = static_cast<float>(seconds * 1e3);
+    this->latencyNext_ = (this->latencyNext_ + 1) % LATENCY_HISTORY;
+    this->latencyCount_ = std::min(this->latencyCount_ + 1, LATENCY_HISTORY);
+}
+
+void FrameProfiler::summarize() {
+    std::array<float, HISTORY> totals{};
+    FrameStats stats;
+    for (size_t i = 0; i < this->count_; ++i) {
+        const FrameSample& s = this->history_[i];
+        totals[i] = s.totalMs;
+        for (size_t k = 0; k < s.sectionMs.size(); ++k) {
+            stats.mean.sectionMs[k] += s.sectionMs[k];
+        }
+        stats.mean.totalMs += s.totalMs;
+        stats.mean.allocations += s.allocations;
+        for (size_t k = 0; k < s.sectionAllocs.size(); ++k) {
+            stats.mean.sectionAllocs[k] += s.sectionAllocs[k];
+        }
+    }
+    auto n = static_cast<float>(this->count_);
+    for (float& ms : stats.mean.sectionMs) ms /= n;
+    stats.mean.totalMs /= n;
+    stats.mean.allocations /= static_cast<uint32_t>(this->count_);
+    for (uint32_t& allocs : stats.mean.sectionAllocs) {
+        allocs /= static_cast<uint32_t>(this->count_);
+    }
+
+    // Rangs exacts, sans tri complet
+    auto values = std::span(totals).first(this->count_);
+    auto at = [&values](float p) {
+        auto rank = static_cast<size_t>(p * static_cast<float>(values.size()));
+        rank = std::min(rank, values.size() - 1);
+        std::ranges::nth_element(values, values.begin() + rank);
+        return values[rank];
+    };
+    stats.p50Ms = at(0.50f);
+    stats.p95Ms = at(0.95f);
+    stats.p99Ms = at(0.99f);
+    stats.maxMs = std::ranges::max(values);
+    if (this->latencyCount_ > 0) {
+        stats.latencyMs = this->lastInputLatencyMs();
+        stats.latencyMaxMs = std::ranges::max(
+            std::span(this->latencyMs_).first(this->latencyCount_));
+    }
+    this->stats_ = stats;
+}
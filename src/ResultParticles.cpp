@@ -0,0 +1,92 @@
+#include "ResultParticles.hpp"
+#include "SwapRemove.hpp"
+#include <algorithm>
+
+namespace {
+constexpr float SPREAD{420.0f};    ///< Vitesse horizontale, pixels/s
+constexpr float MIN_SPEED{250.0f}; ///< Vitesse de montée la plus faible
+constexpr float MAX_SPEED{650.0f};
+constexpr float MIN_SIZE{2.0f};
+constexpr float MAX_SIZE{6.0f};
+} // namespace
+
+float ResultParticles::random() noexcept {
+    this->seed_ ^= this->seed_ << 13U;
+    this->seed_ ^= this->seed_ >> 17U;
+    this->seed_ ^= this->seed_ << 5U;
+    // 24 bits de poids fort : exactement représentables en float
+    return static_cast<float>(this->seed_ >> 8U) * (1.0f / 16777216.0f);
+}
+
+void ResultParticles::burst(Rectangle from, Color color, size_t count) {
+    size_t room = CAPACITY - this->count_;
+    if (count > room) {
+        this->dropped_ += static_cast<uint32_t>(count - room);
+        count = room;
+    }
+    for (size_t k = 0; k < count; ++k) {
+        size_t i = this->count_++;
+        this->x_[i] = from.x + this->random() * from.width;
+        this->y_[i] = from.y;
+        this->vx_[i] = (this->random() - 0.5f) * SPREAD;
+        this->vy_[i] = -(MIN_SPEED + this->random() * (MAX_SPEED - MIN_SPEED));
+        this->life_[i] = 1.0f;
+        this->decay_[i] = 1.0f / (LIFETIME * (0.5f + 0.5f * this->random()));
+        this->size_[i] = MIN_SIZE + this->random() * (MAX_SIZE - MIN_SIZE);
+        this->color_[i] = color;
+    }
+}
+
+void ResultParticles::popup(Vector2 at, const char* text, Color color) {
+    size_t i = this->popupCount_;
+    if (i == POPUP_CAPACITY) {
+        // Le plus ancien est celui qui a le moins de vie
+        auto oldest = std::ranges::min_element(this->popupLife_);
+        i = static_cast<size_t>(oldest - this->popupLife_.begin());
+    } else {
+        ++this->popupCount_;
+    }
+    this->popupPos_[i] = at;
+    this->popupLife_[i] = 1.0f;
+    this->popupText_[i] = text;
+    this->popupColor_[i] = color;
+}
+
+Rectangle ResultParticles::rect(size_t i) const noexcept {
+    float size = this->size_[i];
+    return {this->x_[i] - size / 2.0f, this->y_[i] - size / 2.0f, size, size};
+}
+
+void ResultParticles::clear() noexcept {
+    this->count_ = 0;
+    this->popupCount_ = 0;
+}
+
+bool ResultParticles::animate(float dt) {
+    size_t n = this->count_;
+    size_t p = this->popupCount_;
+    bool visible = n > 0 || p > 0;
+    float fall = GRAVITY * dt;
+
+    // Une passe par grandeur : boucles simples sur tableaux contigus
+    for (size_t i = 0; i < n; ++i) this->vy_[i] += fall;
+    for (size_t i = 0; i < n; ++i) {
+        this->x_[i] += this->vx_[i] * dt;
+        this->y_[i] += this->vy_[i] * dt;
+    }
+    for (size_t i = 0; i < n; ++i) this->life_[i] -= this->decay_[i] * dt;
+    this->count_ = swapRemove(
+        n, [this](size_t i) { return this->life_[i] > 0.0f; }, this->x_,
+        this->y_, this->vx_, this->vy_, this->life_, this->decay_, this->size_,
+        this->color_);
+
+    for (size_t i = 0; i < p; ++i) {
+        this->popupLife_[i] -= dt / POPUP_TIME;
+        this->popupPos_[i].y -= POPUP_RISE * dt;
+    }
+    this->popupCount_ = swapRemove(
+        p, [this](size_t i) { return this->popupLife_[i] > 0.0f; },
+        this->popupPos_, this->popupLife_, this->popupText_,
+        this->popupColor_);
+    return visible;
+}
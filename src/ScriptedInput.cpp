@@ -0,0 +1,179 @@
+#include "ScriptedInput.hpp"
+#include <algorithm>
+
+ScriptedInput::Event& ScriptedInput::add(double time, Event::Kind kind) {
+    this->end_ = std::max(this->end_, time);
+    this->sorted_ = false;
+    Event& event = this->events_.emplace_back();
+    event.time = time;
+    event.kind = kind;
+    return event;
+}
+
+void ScriptedInput::sort() {
+    if (this->sorted_) return;
+    // Stable : les événements d'une même date gardent leur ordre d'écriture
+    std::ranges::stable_sort(this->events_.begin() + this->nextEvent_,
+                             this->events_.end(), {}, &Event::time);
+    std::ranges::stable_sort(this->incoming_.begin() + this->nextIncoming_,
+                             this->incoming_.end(), {}, &Incoming::time);
+    this->sorted_ = true;
+}
+
+double ScriptedInput::nextTime() const {
+    double next = this->end_;
+    if (this->nextEvent_ < this->events_.size()) {
+        next = std::min(next, this->events_[this->nextEvent_].time);
+    }
+    if (this->nextIncoming_ < this->incoming_.size()) {
+        next = std::min(next, this->incoming_[this->nextIncoming_].time);
+    }
+    return next;
+}
+
+ScriptedInput& ScriptedInput::resize(double time, float w, float h) {
+    this->add(time, Event::Kind::RESIZE).value = {w, h};
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::move(double time, Vector2 position) {
+    this->add(time, Event::Kind::MOVE).value = position;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::button(double time, bool down) {
+    this->add(time, Event::Kind::BUTTON).down = down;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::click(double time, Vector2 position) {
+    return this->move(time, position)
+        .button(time, true)
+        .button(time + FRAME_PERIOD, false);
+}
+
+ScriptedInput& ScriptedInput::wheel(double time, float steps) {
+    this->add(time, Event::Kind::WHEEL).value = {steps, 0.0f};
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::press(double time, InputKey key) {
+    this->add(time, Event::Kind::KEY).key = key;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::keyDown(double time, int32_t key) {
+    Event& event = this->add(time, Event::Kind::KEY_CODE);
+    event.code = key;
+    event.down = true;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::keyUp(double time, int32_t key) {
+    this->add(time, Event::Kind::KEY_CODE).code = key;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::type(double time, std::string_view text) {
+    this->add(time, Event::Kind::TEXT).text = text;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::receive(double time, Message message) {
+    this->end_ = std::max(this->end_, time);
+    this->incoming_.push_back({time, std::move(message)});
+    this->sorted_ = false;
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::dropLink(double time) {
+    this->add(time, Event::Kind::DROP);
+    return *this;
+}
+
+ScriptedInput& ScriptedInput::quitAt(double time) {
+    this->end_ = std::max(this->end_, time);
+    return *this;
+}
+
+void ScriptedInput::attach(Communication& comm) {
+    this->link_ = &comm;
+    this->sent_.clear();
+    comm.setLoopback(
+        [this](const Message& msg) { this->sent_.push_back(msg); });
+}
+
+void ScriptedInput::detach() {
+    if (this->link_ == nullptr) return;
+    this->link_->disconnect();
+    this->link_->setLoopback({});
+    this->link_ = nullptr;
+}
+
+void ScriptedInput::poll(InputFrame& frame) {
+    this->sort();
+    // Fermeture une fois le dernier événement traité par une image
+    frame.quit = this->clock_ >= this->end_ &&
+                 this->nextEvent_ == this->events_.size() &&
+                 this->nextIncoming_ == this->incoming_.size();
+    bool wasDown = this->buttonDown_;
+    frame.clicked = false;
+    frame.wheel = 0.0f;
+    frame.typed.clear();
+    frame.keys.reset();
+    frame.keyEventCount = 0;
+    frame.activity = false;
+
+    while (this->nextEvent_ < this->events_.size() &&
+           this->events_[this->nextEvent_].time <= this->clock_) {
+        const Event& e = this->events_[this->nextEvent_++];
+        switch (e.kind) {
+        case Event::Kind::RESIZE: this->screen_ = e.value; break;
+        case Event::Kind::MOVE: this->mouse_ = e.value; break;
+        case Event::Kind::BUTTON:
+            // Appui et relâchement dans la même image : clic quand même
+            frame.clicked = frame.clicked || (e.down && !wasDown);
+            this->buttonDown_ = e.down;
+            wasDown = e.down;
+            break;
+        case Event::Kind::WHEEL: frame.wheel += e.value.x; break;
+        case Event::Kind::KEY:
+            frame.keys.set(static_cast<size_t>(e.key));
+            break;
+        case Event::Kind::KEY_CODE:
+            // Datée à l'événement, comme le rappel GLFW, et non à l'image
+            if (frame.keyEventCount < frame.keyEvents.size()) {
+                frame.keyEvents[frame.keyEventCount++] = {e.code, e.down,
+                                                          e.time};
+            }
+            break;
+        case Event::Kind::TEXT: frame.typed += e.text; break;
+        case Event::Kind::DROP:
+            if (this->link_ != nullptr) this->link_->disconnect();
+            break;
+        }
+        frame.activity = true;
+    }
+
+    // Messages arrivés depuis l'image précédente, comme le thread d'écoute
+    while (this->nextIncoming_ < this->incoming_.size() &&
+           this->incoming_[this->nextIncoming_].time <= this->clock_) {
+        if (this->link_ != nullptr) {
+            this->link_->inject(this->incoming_[this->nextIncoming_].message);
+        }
+        ++this->nextIncoming_;
+    }
+
+    frame.time = this->clock_;
+    frame.screenW = this->screen_.x;
+    frame.screenH = this->screen_.y;
+    frame.mouse = this->mouse_;
+    frame.pointers[0] = {-1, this->mouse_, this->buttonDown_};
+    frame.pointerCount = 1;
+}
+
+void ScriptedInput::wait(double seconds) {
+    this->sort();
+    this->clock_ = std::max(this->clock_,
+                            std::min(this->clock_ + seconds, this->nextTime()));
+}
@@ -0,0 +1,49 @@
+#include "Session.hpp"
+#include <algorithm>
+
+void SessionDriver::wake(std::optional<Message> msg) {
+    // La coroutine peut se suspendre à nouveau pendant la reprise
+    std::coroutine_handle<> handle = std::exchange(this->waiter_, {});
+    this->awaited_.clear();
+    this->remaining_ = 0.0f;
+    this->received_ = std::move(msg);
+    handle.resume();
+    if (!this->task_.running()) this->task_ = {};
+}
+
+void SessionDriver::start(SessionTask task) {
+    this->cancel();
+    this->task_ = std::move(task);
+    this->task_.resume();
+    if (!this->task_.running()) this->task_ = {};
+}
+
+bool SessionDriver::deliver(const Message& msg) {
+    if (!this->waiter_ ||
+        std::ranges::find(this->awaited_, msg.getType()) ==
+            this->awaited_.end()) {
+        return false;
+    }
+    this->wake(msg);
+    return true;
+}
+
+bool SessionDriver::tick(float dt) {
+    if (!this->waiter_ || this->remaining_ <= 0.0f) return false;
+    this->remaining_ -= dt;
+    if (this->remaining_ > 0.0f) return false;
+    this->wake(std::nullopt);
+    return true;
+}
+
+void SessionDriver::skip() {
+    if (this->waiter_) this->wake(std::nullopt);
+}
+
+void SessionDriver::cancel() {
+    this->waiter_ = {};
+    this->awaited_.clear();
+    this->remaining_ = 0.0f;
+    this->received_.reset();
+    this->task_ = {};
+}
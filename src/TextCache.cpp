@@ -0,0 +1,153 @@
+#include "TextCache.hpp"
+#include "Logger.hpp"
+
+namespace {
+/// Nombre de codepoints rastérisés : ASCII, Latin-1 et quelques symboles
+constexpr size_t CODEPOINT_COUNT{95 + 96 + 5};
+
+/**
+ * @brief Codepoints présents dans les atlas (accents français, « … », ♭, ♯)
+ * @return Liste des codepoints
+ */
+constexpr std::array<int, CODEPOINT_COUNT> atlasCodepoints() {
+    std::array<int, CODEPOINT_COUNT> codepoints{};
+    size_t n = 0;
+    for (int c = 0x20; c <= 0x7E; ++c) codepoints[n++] = c;
+    for (int c = 0xA0; c <= 0xFF; ++c) codepoints[n++] = c;
+    for (int c : {0x152, 0x153, 0x2026, 0x266D, 0x266F}) codepoints[n++] = c;
+    return codepoints;
+}
+
+/**
+ * @brief Rang de l'atlas le plus petit couvrant une taille
+ * @return Rang dans `TextCache::ATLAS_SIZES`, le dernier à défaut
+ */
+size_t atlasIndex(int32_t size) {
+    const auto& sizes = TextCache::ATLAS_SIZES;
+    const auto* it = std::lower_bound(sizes.begin(), sizes.end(), size);
+    return it == sizes.end() ? sizes.size() - 1
+                             : static_cast<size_t>(it - sizes.begin());
+}
+} // namespace
+
+void TextCache::load(const std::string& path) {
+    this->unload();
+    bool found = !path.empty() && FileExists(path.c_str());
+    if (!path.empty() && !found) {
+        Logger::err("[UI] Police introuvable : {}, police par défaut", path);
+    }
+    auto codepoints = atlasCodepoints();
+    for (size_t i = 0; i < ATLAS_SIZES.size(); ++i) {
+        if (found) {
+            Font font = LoadFontEx(path.c_str(), ATLAS_SIZES[i],
+                                   codepoints.data(),
+                                   static_cast<int>(codepoints.size()));
+            if (font.texture.id != 0 && font.glyphs != nullptr) {
+                SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+                this->fonts_[i] = font;
+                this->owned_[i] = true;
+                continue;
+            }
+        }
+        // Police bitmap intégrée : un seul atlas, agrandi selon la taille
+        this->fonts_[i] = GetFontDefault();
+    }
+    Logger::log("[UI] Atlas de police : {}", found ? path : "par défaut");
+}
+
+void TextCache::unload() {
+    this->runs_.clear();
+    this->formatted_.clear();
+    this->count_ = 0;
+    for (size_t i = 0; i < ATLAS_SIZES.size(); ++i) {
+        if (this->owned_[i]) UnloadFont(this->fonts_[i]);
+        this->fonts_[i] = {};
+        this->owned_[i] = false;
+    }
+}
+
+const Font& TextCache::fontFor(int32_t size) {
+    size_t index = atlasIndex(size);
+    if (this->fonts_[index].glyphs == nullptr) {
+        this->fonts_[index] = GetFontDefault();
+    }
+    return this->fonts_[index];
+}
+
+TextRun TextCache::build(std::string_view text, int32_t size) {
+    const Font& font = this->fontFor(size);
+    TextRun run;
+    run.font = &font;
+    if (font.glyphs == nullptr || font.baseSize == 0) return run;
+
+    // Mêmes métriques que DrawText : espacement de taille/10 pour la police
+    // bitmap, 0 pour un atlas TTF déjà crénelé
+    size = std::max(size, 10);
+    float scale = static_cast<float>(size) / static_cast<float>(font.baseSize);
+    float spacing =
+        this->owned_[atlasIndex(size)] ? 0.0f : static_cast<float>(size / 10);
+    auto pad = static_cast<float>(font.glyphPadding);
+    auto texW = static_cast<float>(font.texture.width);
+    auto texH = static_cast<float>(font.texture.height);
+
+    std::string terminated(text); // GetCodepointNext lit jusqu'au '\0'
+    float x = 0.0f;
+    float y = 0.0f;
+    for (size_t i = 0; i < terminated.size();) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&terminated[i], &bytes);
+        i += static_cast<size_t>(std::max(bytes, 1));
+        if (codepoint == '\n') {
+            x = 0.0f;
+            y += static_cast<float>(size) * 1.2f;
+            continue;
+        }
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            Rectangle src = {rec.x - pad, rec.y - pad, rec.width + 2.0f * pad,
+                             rec.height + 2.0f * pad};
+            run.quads.push_back(
+                {src.x / texW, src.y / texH, (src.x + src.width) / texW,
+                 (src.y + src.height) / texH,
+                 {x + (static_cast<float>(glyph.offsetX) - pad) * scale,
+                  y + (static_cast<float>(glyph.offsetY) - pad) * scale,
+                  src.width * scale, src.height * scale}});
+        }
+        float advance = glyph.advanceX == 0
+                            ? rec.width
+                            : static_cast<float>(glyph.advanceX);
+        x += advance * scale + spacing;
+        run.width = std::max(run.width, x - spacing);
+    }
+    return run;
+}
+
+void TextCache::reserveSlot() {
+    // Noms saisis, scores : vidage complet plutôt qu'un LRU, rare en pratique
+    if (++this->count_ <= MAX_RUNS) return;
+    this->runs_.clear();
+    this->formatted_.clear();
+    this->count_ = 1;
+}
+
+const TextRun& TextCache::get(std::string_view text, int32_t size) {
+    auto bySize = std::ranges::find(this->runs_, size,
+                                    &std::pair<int32_t, RunMap>::first);
+    if (bySize != this->runs_.end()) {
+        auto it = bySize->second.find(text);
+        if (it != bySize->second.end()) return it->second;
+    }
+
+    TextRun run = this->build(text, size);
+    this->reserveSlot();
+    // Le vidage a pu invalider la recherche précédente
+    bySize = std::ranges::find(this->runs_, size,
+                               &std::pair<int32_t, RunMap>::first);
+    if (bySize == this->runs_.end()) {
+        bySize = this->runs_.emplace(this->runs_.end(), size, RunMap{});
+    }
+    return bySize->second.emplace(std::string(text), std::move(run))
+        .first->second;
+}
@@ -0,0 +1,72 @@
+#include "ThreadTuning.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+namespace ThreadTuning {
+
+namespace {
+/**
+ * @brief Épingle le thread appelant sur un cœur
+ * @param cpu Index du cœur
+ * @return Description du résultat
+ */
+std::string pinToCpu(int32_t cpu) {
+    auto cores = static_cast<int32_t>(std::thread::hardware_concurrency());
+    if (cpu >= CPU_SETSIZE || (cores > 0 && cpu >= cores)) {
+        return std::format("cœur {} inexistant, affinité libre", cpu);
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        return std::format("cœur {} refusé ({}), affinité libre", cpu,
+                           std::strerror(err));
+    }
+    return std::format("cœur {}", cpu);
+}
+
+/**
+ * @brief Change le niveau nice du seul thread appelant (Linux)
+ * @param nice Niveau voulu
+ * @return Description du résultat
+ */
+std::string setNice(int32_t nice) {
+    auto tid = static_cast<id_t>(gettid());
+    if (setpriority(PRIO_PROCESS, tid, nice) != 0) {
+        return std::format("nice {} refusé ({}), CFS par défaut", nice,
+                           std::strerror(errno));
+    }
+    return std::format("CFS nice {}", getpriority(PRIO_PROCESS, tid));
+}
+} // namespace
+
+std::string applyToCurrentThread(const ThreadPolicy& policy) {
+    if (policy.isDefault()) return "ordonnancement par défaut";
+    std::string applied;
+    if (policy.cpu >= 0) applied = pinToCpu(policy.cpu) + ", ";
+
+    // SCHED_FIFO demandé : repli sur nice si CAP_SYS_NICE/RLIMIT_RTPRIO manque
+    if (policy.fifoPriority > 0) {
+        sched_param param{};
+        param.sched_priority =
+            std::min(policy.fifoPriority, sched_get_priority_max(SCHED_FIFO));
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err == 0) {
+            return applied +
+                   std::format("SCHED_FIFO priorité {}", param.sched_priority);
+        }
+        applied += std::format("SCHED_FIFO refusé ({}), ", std::strerror(err));
+    }
+    if (policy.nice != 0) return applied + setNice(policy.nice);
+    return applied + "CFS par défaut";
+}
+
+} // namespace ThreadTuning
@@ -1,130 +1,130 @@
 #include "UI.hpp"
 #include "AppController.hpp"
+#include "DrawList.hpp"
 #include "MusicUtils.hpp"
 #include <format>
 
 using namespace Colors;
 
-void UI::draw(AppController& app, Vector2 mouse, float screenW, float screenH) {
+namespace {
+constexpr float HUD_BAR_W{2.0f};     ///< Largeur d'une image dans le graphe
+constexpr float HUD_GRAPH_H{80.0f};  ///< Hauteur du graphe
+constexpr float HUD_GRAPH_MS{33.3f}; ///< Durée en haut du graphe
+constexpr int32_t HUD_FONT{16};
+/// Couleur de chaque étape dans le graphe, dans l'ordre de `FrameSection`
+constexpr std::array<Color, static_cast<size_t>(FrameSection::COUNT)>
+    HUD_COLORS{SKYBLUE, ORANGE, LIME, GRAY};
+
+/**
+ * @brief Dessine une ligne du HUD, formatée dans un tampon local : ces textes
+ * changent à chaque image et videraient le cache de textes préparés
+ * @param out Liste de dessin
+ * @param pos Coin haut gauche
+ * @param fmt Format `std::format`
+ * @param args Arguments
+ */
+template <typename... Args>
+void drawHudLine(DrawList& out, Vector2 pos, std::format_string<Args...> fmt,
+                 Args&&... args) {
+    std::array<char, 96> buffer{};
+    auto result = std::format_to_n(buffer.data(), buffer.size(), fmt,
+                                   std::forward<Args>(args)...);
+    auto length = std::min(static_cast<size_t>(result.size), buffer.size());
+    out.plainText({buffer.data(), length}, pos, HUD_FONT, RAYWHITE);
+}
+} // namespace
+
+void UI::record(AppController& app, DrawList& out, float screenW,
+                float screenH) {
+    app.arena_.reset();
     if (app.errorTimer_ > 0.0f) {
         float alpha = (app.errorTimer_ < 1.0f) ? app.errorTimer_ : 1.0f;
-        DrawRectangle(0, (int)screenH - 50, (int)screenW, 50,
-                      Fade(kRougeErreur, alpha * 0.85f));
-        DrawText(app.errorMsg_.c_str(),
-                 (int)screenW / 2 - MeasureText(app.errorMsg_.c_str(), 18) / 2,
-                 (int)screenH - 36, 18, Fade(WHITE, alpha));
+        out.rect({0.0f, screenH - 50.0f, screenW, 50.0f},
+                 Fade(kRougeErreur, alpha * 0.85f));
+        out.textCentered(app.text_.get(app.errorMsg_, 18),
+                         {screenW / 2, screenH - 36}, Fade(WHITE, alpha));
     }
 
     switch (app.appState_) {
     case AppState::PROFILE_SELECT:
-        drawProfileSelect(app, mouse, screenW, screenH);
+        drawProfileSelect(app, out, screenW, screenH);
         break;
-    case AppState::MENU: drawMenu(app, mouse, screenW, screenH); break;
-    case AppState::PLAY: drawPlay(app, mouse, screenW, screenH); break;
-    case AppState::GAME_OVER: drawGameOver(app, mouse, screenW, screenH); break;
+    case AppState::MENU: drawMenu(app, out, screenW, screenH); break;
+    case AppState::PLAY: drawPlay(app, out, screenW, screenH); break;
+    case AppState::GAME_OVER: drawGameOver(app, out, screenW, screenH); break;
     }
+
+    if (app.profiler_.visible()) drawProfiler(out, app.profiler_, screenW);
 }
 
-bool UI::drawButton(Rectangle rec, const char* text, Color color, Vector2 mouse,
+void UI::drawButton(DrawList& out, TextCache& texts, Rectangle rec,
+                    const char* text, Color color, bool hover,
                     int32_t fontSize) {
-    bool hover = CheckCollisionPointRec(mouse, rec);
     if (hover) {
-        DrawRectangleRec(rec, Fade(color, 0.3f));
-        DrawRectangleLinesEx(rec, 3, color);
+        out.rect(rec, Fade(color, 0.3f));
+        out.rectLines(rec, 3, color);
     } else {
-        DrawRectangleLinesEx(rec, 2, Fade(color, 0.6f));
+        out.rectLines(rec, 2, Fade(color, 0.6f));
     }
-    int32_t textWidth = MeasureText(text, fontSize);
-    DrawText(text, (int32_t)(rec.x + rec.width / 2 - textWidth / 2),
-             (int32_t)(rec.y + rec.height / 2 - fontSize / 2), fontSize,
-             hover ? WHITE : color);
-    return hover;
+    out.textCentered(texts.get(text, fontSize),
+                     {rec.x + rec.width / 2,
+                      rec.y + rec.height / 2 - (float)(fontSize / 2)},
+                     hover ? WHITE : color);
 }
 
-void UI::drawStaff(const AppController& app, Rectangle rec,
-                   const std::vector<std::string>& notes, Color color) {
+void UI::drawStaffBackground(DrawList& out, Rectangle rec, Color color,
+                             Texture2D clef) {
     float lineSpacing = rec.height / 6.0f;
     float centerY = rec.y + rec.height / 2.0f;
 
     // Dessin des 5 lignes (E4, G4, B4, D5, F5 en clé de sol simplifiée)
     for (int i = 0; i < 5; i++) {
         float y = centerY + (2 - i) * lineSpacing;
-        DrawLineEx({rec.x, y}, {rec.x + rec.width, y}, 2, color);
+        out.line({rec.x, y}, {rec.x + rec.width, y}, 2, color);
     }
 
     // Barres de mesure de début et de fin pour fermer la portée
-    DrawLineEx({rec.x, centerY - 2 * lineSpacing},
-               {rec.x, centerY + 2 * lineSpacing}, 2, color);
-    DrawLineEx({rec.x + rec.width, centerY - 2 * lineSpacing},
-               {rec.x + rec.width, centerY + 2 * lineSpacing}, 2, color);
-
-    static Texture2D clefTexture{};
-    static bool clefTextureLoaded = false;
-    if (!clefTextureLoaded) {
-        Image img =
-            LoadImage("GClef.png"); // Changé en .png car Raylib ne supporte pas
-                                    // le SVG sur cette installation
-        if (img.data != nullptr) {
-            clefTexture = LoadTextureFromImage(img);
-            SetTextureFilter(clefTexture, TEXTURE_FILTER_BILINEAR);
-            UnloadImage(img);
-        }
-        clefTextureLoaded = true;
-    }
+    out.line({rec.x, centerY - 2 * lineSpacing},
+             {rec.x, centerY + 2 * lineSpacing}, 2, color);
+    out.line({rec.x + rec.width, centerY - 2 * lineSpacing},
+             {rec.x + rec.width, centerY + 2 * lineSpacing}, 2, color);
 
-    if (clefTexture.id != 0) {
+    // GClef.png embarqué (raylib ne lit pas le SVG), chargé au démarrage
+    if (clef.id != 0) {
         float targetHeight = 6.0f * lineSpacing;
         float scale = targetHeight / 400.0f;
         float cx = rec.x + 10.0f;
         float cy = centerY - 2.5f * lineSpacing;
-        DrawTextureEx(clefTexture, {cx, cy}, 0.0f, scale, color);
+        out.texture(clef, {cx, cy}, scale, color);
     } else {
         float cx = rec.x + 30.0f;
         float cyG = centerY + lineSpacing; // Ligne du Sol (G4)
-        DrawCircleLines((int)cx, (int)cyG, lineSpacing * 0.5f, color);
-        DrawCircleLines((int)cx, (int)(cyG - lineSpacing), lineSpacing * 0.8f,
-                        color);
-        DrawLineEx({cx + lineSpacing * 0.3f, centerY - 2.5f * lineSpacing},
-                   {cx + lineSpacing * 0.3f, centerY + 3.0f * lineSpacing},
-                   2.0f, color);
-        DrawCircleLines((int)(cx - lineSpacing * 0.1f),
-                        (int)(centerY + 3.0f * lineSpacing), lineSpacing * 0.4f,
-                        color);
+        out.circleLines({cx, cyG}, lineSpacing * 0.5f, color);
+        out.circleLines({cx, cyG - lineSpacing}, lineSpacing * 0.8f, color);
+        out.line({cx + lineSpacing * 0.3f, centerY - 2.5f * lineSpacing},
+                 {cx + lineSpacing * 0.3f, centerY + 3.0f * lineSpacing}, 2.0f,
+                 color);
+        out.circleLines({cx - lineSpacing * 0.1f, centerY + 3.0f * lineSpacing},
+                        lineSpacing * 0.4f, color);
     }
+}
+
+void UI::drawStaff(DrawList& out, CachedLayer& background, TextCache& texts,
+                   Texture2D clef, Rectangle rec,
+                   const std::vector<std::string>& notes, Color color) {
+    float lineSpacing = rec.height / 6.0f;
+    float centerY = rec.y + rec.height / 2.0f;
+
+    // Lignes, barres et clé en cache ; la clé déborde d'une interligne
+    Rectangle bounds = {rec.x - 2.0f, rec.y - lineSpacing, rec.width + 4.0f,
+                        rec.height + 2.0f * lineSpacing};
+    out.layer(background, bounds, LayerKey().add(rec).add(color).add(clef.id),
+              [&] { drawStaffBackground(out, rec, color, clef); });
 
     float noteX = rec.x + rec.width / 2.0f;
     float noteRadius = lineSpacing * 0.45f;
 
-    for (std::string note : notes) {
-        // Optionnel: mapper la note reçue aux notes de la gamme sélectionnée.
-        // L'engin peut envoyer "d#" pour "eb". Si "eb" est dans la gamme, on le
-        // remplace.
-        std::vector<std::string> scaleNotes = MusicUtils::getScaleNotesList(
-            app.selectedScale_, app.selectedMode_);
-        if (note.size() >= 2 && note[1] == '#') {
-            std::string base = note.substr(0, 2); // ex: "d#"
-            std::string octave = note.substr(2);  // ex: "4"
-            std::string mappedFlat = "";
-            if (base == "c#") mappedFlat = "db";
-            else if (base == "d#") mappedFlat = "eb";
-            else if (base == "f#") mappedFlat = "gb";
-            else if (base == "g#") mappedFlat = "ab";
-            else if (base == "a#") mappedFlat = "bb";
-
-            if (!mappedFlat.empty()) {
-                bool flatInScale = false;
-                for (const auto& sn : scaleNotes) {
-                    if (sn == mappedFlat) {
-                        flatInScale = true;
-                        break;
-                    }
-                }
-                if (flatInScale) {
-                    note = mappedFlat + octave;
-                }
-            }
-        }
-
+    for (const std::string& note : notes) {
         NoteKey nk = MusicUtils::resolveKey(note);
         if (!nk.valid) continue;
 
@@ -150,545 +150,448 @@ void UI::drawStaff(const AppController& app, Rectangle rec,
             for (int p = 0; p >= whiteIndex; p -= 2) {
                 float ly = centerY +
                            (3.0f - static_cast<float>(p) / 2.0f) * lineSpacing;
-                DrawLineEx({noteX - noteRadius * 1.5f, ly},
-                           {noteX + noteRadius * 1.5f, ly}, 2, color);
+                out.line({noteX - noteRadius * 1.5f, ly},
+                         {noteX + noteRadius * 1.5f, ly}, 2, color);
             }
         } else if (whiteIndex >= 12) { // A5 et au dessus
             for (int p = 12; p <= whiteIndex; p += 2) {
                 float ly = centerY +
                            (3.0f - static_cast<float>(p) / 2.0f) * lineSpacing;
-                DrawLineEx({noteX - noteRadius * 1.5f, ly},
-                           {noteX + noteRadius * 1.5f, ly}, 2, color);
+                out.line({noteX - noteRadius * 1.5f, ly},
+                         {noteX + noteRadius * 1.5f, ly}, 2, color);
             }
         }
 
         // Tête de note (noire)
-        DrawEllipse((int)noteX, (int)noteY, noteRadius * 1.2f, noteRadius,
-                    color);
+        out.ellipse({noteX, noteY}, noteRadius * 1.2f, noteRadius, color);
 
         // Hampe (stem)
         float stemLen = lineSpacing * 3.0f;
         if (whiteIndex < 6) { // Sous la ligne du milieu (B4)
-            DrawLineEx({noteX + noteRadius * 1.1f, noteY},
-                       {noteX + noteRadius * 1.1f, noteY - stemLen}, 2, color);
+            out.line({noteX + noteRadius * 1.1f, noteY},
+                     {noteX + noteRadius * 1.1f, noteY - stemLen}, 2, color);
         } else {
-            DrawLineEx({noteX - noteRadius * 1.1f, noteY},
-                       {noteX - noteRadius * 1.1f, noteY + stemLen}, 2, color);
+            out.line({noteX - noteRadius * 1.1f, noteY},
+                     {noteX - noteRadius * 1.1f, noteY + stemLen}, 2, color);
         }
 
         // Altérations (si note noire)
         if (nk.isBlack) {
             bool isSharp = (note.find('#') != std::string::npos);
             const char* altTxt = isSharp ? "#" : "b";
-            DrawText(altTxt, (int)(noteX - noteRadius * 2.5f),
-                     (int)(noteY - noteRadius), (int)(lineSpacing * 1.5f),
-                     color);
+            out.text(texts.get(altTxt, (int)(lineSpacing * 1.5f)),
+                     {noteX - noteRadius * 2.5f, noteY - noteRadius}, color);
         }
     }
 }
 
-void UI::drawProfileSelect(AppController& app, Vector2 mouse, float screenW,
+void UI::drawProfileSelect(AppController& app, DrawList& out, float screenW,
                            float screenH) {
-    DrawText("SESSIONS UTILISATEURS",
-             (int)screenW / 2 - MeasureText("SESSIONS UTILISATEURS", 30) / 2,
-             (int)(screenH * 0.15f), 30, kVertEclatant);
-
-    float totalW = app.profiles_.size() * 200.0f +
-                   ((app.profiles_.size() < 4) ? 200.0f : 0.0f) - 20.0f;
-    float startX = screenW / 2.0f - totalW / 2.0f;
+    TextCache& texts = app.text_;
+    out.textCentered(texts.get("SESSIONS UTILISATEURS", 30),
+                     {screenW / 2, screenH * 0.15f}, kVertEclatant);
 
+    const Layout& layout = app.layout_;
     for (size_t i = 0; i < app.profiles_.size(); i++) {
-        Rectangle r = {startX + i * 200.0f, screenH / 2.0f - 110.0f, 180.0f,
-                       220.0f};
-        Rectangle rDel = {r.x + 150.0f, r.y + 5.0f, 25.0f, 25.0f};
-        bool hov = CheckCollisionPointRec(mouse, r);
-        bool hovDel = CheckCollisionPointRec(mouse, rDel);
-
-        DrawRectangleRec(r, Fade(app.profiles_[i].color, hov ? 0.3f : 0.1f));
-        DrawRectangleLinesEx(r, hov ? 3 : 2, app.profiles_[i].color);
-        DrawText(app.profiles_[i].name.c_str(), (int)r.x + 15, (int)r.y + 100,
-                 22, hov ? WHITE : app.profiles_[i].color);
-        DrawText(std::format("Record: {}", app.profiles_[i].topScore).c_str(),
-                 (int)r.x + 15, (int)r.y + 140, 15,
-                 Fade(app.profiles_[i].color, 0.8f));
-
-        DrawRectangleRec(rDel,
-                         hovDel ? kRougeErreur : Fade(kRougeErreur, 0.6f));
-        DrawText("X", (int)rDel.x + 7, (int)rDel.y + 4, 20, WHITE);
+        auto idx = static_cast<int32_t>(i);
+        Rectangle r = layout.rect(Widget::PROFILE_CARD, idx);
+        Rectangle rDel = layout.rect(Widget::PROFILE_DELETE, idx);
+        bool hovDel = layout.hovered(Widget::PROFILE_DELETE, idx);
+        bool hov = hovDel || layout.hovered(Widget::PROFILE_CARD, idx);
+
+        out.rect(r, Fade(app.profiles_[i].color, hov ? 0.3f : 0.1f));
+        out.rectLines(r, hov ? 3 : 2, app.profiles_[i].color);
+        out.text(texts.get(app.profiles_[i].name, 22), {r.x + 15, r.y + 100},
+                 hov ? WHITE : app.profiles_[i].color);
+        out.text(texts.format(15, "Record: {}", app.profiles_[i].topScore),
+                 {r.x + 15, r.y + 140}, Fade(app.profiles_[i].color, 0.8f));
+
+        out.rect(rDel, hovDel ? kRougeErreur : Fade(kRougeErreur, 0.6f));
+        out.text(texts.get("X", 20), {rDel.x + 7, rDel.y + 4}, WHITE);
     }
 
     if (app.profiles_.size() < 4 && !app.isNamingProfile_) {
-        Rectangle rP = {startX + app.profiles_.size() * 200.0f,
-                        screenH / 2.0f - 110.0f, 180.0f, 220.0f};
-        bool hov = CheckCollisionPointRec(mouse, rP);
-        DrawRectangleRec(rP, Fade(kVertEclatant, hov ? 0.3f : 0.1f));
-        DrawRectangleLinesEx(rP, hov ? 3 : 2, Fade(kVertEclatant, 0.5f));
-        DrawText("+", (int)rP.x + 75, (int)rP.y + 80, 60,
+        Rectangle rP = layout.rect(Widget::PROFILE_ADD);
+        bool hov = layout.hovered(Widget::PROFILE_ADD);
+        out.rect(rP, Fade(kVertEclatant, hov ? 0.3f : 0.1f));
+        out.rectLines(rP, hov ? 3 : 2, Fade(kVertEclatant, 0.5f));
+        out.text(texts.get("+", 60), {rP.x + 75, rP.y + 80},
                  hov ? WHITE : Fade(kVertEclatant, 0.5f));
     }
 
     if (app.isNamingProfile_) {
-        DrawRectangle(0, 0, (int)screenW, (int)screenH, Fade(BLACK, 0.8f));
-        DrawText("NOM DU NOUVEAU PROFIL :", (int)screenW / 2 - 140,
-                 (int)screenH / 2 - 50, 20, kVertEclatant);
-        DrawText(app.inputName_.c_str(),
-                 (int)screenW / 2 - MeasureText(app.inputName_.c_str(), 40) / 2,
-                 (int)screenH / 2, 40, WHITE);
-        DrawText("ESC pour annuler", (int)screenW / 2 - 70,
-                 (int)screenH / 2 + 60, 15, GRAY);
+        out.rect({0.0f, 0.0f, screenW, screenH}, Fade(BLACK, 0.8f));
+        out.text(texts.get("NOM DU NOUVEAU PROFIL :", 20),
+                 {screenW / 2 - 140, screenH / 2 - 50}, kVertEclatant);
+        out.textCentered(texts.get(app.inputName_, 40),
+                         {screenW / 2, screenH / 2}, WHITE);
+        out.text(texts.get("ESC pour annuler", 15),
+                 {screenW / 2 - 70, screenH / 2 + 60}, GRAY);
     }
 }
 
-void UI::drawMenu(AppController& app, Vector2 mouse, float screenW,
+void UI::drawMenu(AppController& app, DrawList& out, float screenW,
                   float screenH) {
-    DrawText(std::format("JOUEUR: {}", app.profiles_[app.currentUserIdx_].name)
-                 .c_str(),
-             40, 40, 25, app.profiles_[app.currentUserIdx_].color);
-    DrawText(
-        std::format("RECORD: {}", app.profiles_[app.currentUserIdx_].topScore)
-            .c_str(),
-        (int)screenW - 200, 40, 25, kVertEclatant);
+    // Menu entier en cache, redessiné seulement si un réglage, le profil ou
+    // l'élément survolé change
+    const UserProfile& user = app.profiles_[app.currentUserIdx_];
+    LayerKey key;
+    key.add(screenW)
+        .add(screenH)
+        .add(app.layout_.hover().widget)
+        .add(app.layout_.hover().index)
+        .add(std::string_view(user.name))
+        .add(user.topScore)
+        .add(user.color)
+        .add(app.selectedScale_)
+        .add(app.selectedMode_)
+        .add(app.selectedNotation_)
+        .add(app.showKeyboard_)
+        .add(app.showFallingNotes_);
+    for (const auto& game : app.availableGames_) {
+        key.add(std::string_view(game.name));
+    }
+    out.layer(app.layers_[Layer::MENU], {0.0f, 0.0f, screenW, screenH}, key,
+              [&] { drawMenuContent(app, out, screenW, screenH); });
+}
+
+void UI::drawMenuContent(AppController& app, DrawList& out, float screenW,
+                         float screenH) {
+    TextCache& texts = app.text_;
+    const UserProfile& user = app.profiles_[app.currentUserIdx_];
+    out.text(texts.format(25, "JOUEUR: {}", user.name), {40, 40}, user.color);
+    out.text(texts.format(25, "RECORD: {}", user.topScore),
+             {screenW - 200, 40}, kVertEclatant);
 
+    const Layout& layout = app.layout_;
     for (size_t i = 0; i < app.availableGames_.size(); i++) {
-        Rectangle r = {screenW / 2.0f - 250.0f, screenH * 0.3f + i * 100.0f,
-                       500.0f, 80.0f};
-        (void)drawButton(r, app.availableGames_[i].name.c_str(), kVertEclatant,
-                         mouse, 25);
+        auto idx = static_cast<int32_t>(i);
+        drawButton(out, texts, layout.rect(Widget::MENU_GAME, idx),
+                   app.availableGames_[i].name.c_str(), kVertEclatant,
+                   layout.hovered(Widget::MENU_GAME, idx), 25);
     }
 
     // Gamme
-    float scaleStartX = screenW / 2.0f - (7.0f * 70.0f) / 2.0f;
     const char* scaleLabels[] = {"C", "D", "E", "F", "G", "A", "B"};
     for (int i = 0; i < 7; i++) {
-        Rectangle r = {scaleStartX + i * 70.0f, screenH * 0.75f, 60.0f, 40.0f};
+        Rectangle r = layout.rect(Widget::MENU_SCALE, i);
         bool sel = (app.selectedScale_ == static_cast<ScaleChoice>(i));
-        bool hov = CheckCollisionPointRec(mouse, r);
-        DrawRectangleRec(r,
-                         Fade(kVertEclatant, sel ? 0.3f : (hov ? 0.2f : 0.0f)));
-        DrawRectangleLinesEx(r, hov || sel ? 3 : 2,
-                             sel ? kVertEclatant : Fade(kVertEclatant, 0.4f));
-        DrawText(scaleLabels[i],
-                 (int)r.x + 30 - MeasureText(scaleLabels[i], 20) / 2,
-                 (int)r.y + 10, 20,
-                 (hov || sel) ? WHITE : Fade(kVertEclatant, 0.4f));
+        bool hov = layout.hovered(Widget::MENU_SCALE, i);
+        out.rect(r, Fade(kVertEclatant, sel ? 0.3f : (hov ? 0.2f : 0.0f)));
+        out.rectLines(r, hov || sel ? 3 : 2,
+                      sel ? kVertEclatant : Fade(kVertEclatant, 0.4f));
+        out.textCentered(texts.get(scaleLabels[i], 20), {r.x + 30, r.y + 10},
+                         (hov || sel) ? WHITE : Fade(kVertEclatant, 0.4f));
     }
 
     // Mode
     const char* modes[] = {"MAJ", "MIN"};
     for (int i = 0; i < 2; i++) {
-        Rectangle r = {screenW / 2.0f - 75.0f + i * 80.0f, screenH * 0.85f,
-                       70.0f, 40.0f};
+        Rectangle r = layout.rect(Widget::MENU_MODE, i);
         bool sel = ((i == 0) == (app.selectedMode_ == ModeChoice::MODE_MAJ));
-        bool hov = CheckCollisionPointRec(mouse, r);
-        DrawRectangleRec(r,
-                         Fade(kVertEclatant, sel ? 0.3f : (hov ? 0.2f : 0.0f)));
-        DrawRectangleLinesEx(r, hov || sel ? 3 : 2,
-                             sel ? kVertEclatant : Fade(kVertEclatant, 0.4f));
-        DrawText(modes[i], (int)r.x + 35 - MeasureText(modes[i], 20) / 2,
-                 (int)r.y + 10, 20,
-                 (hov || sel) ? WHITE : Fade(kVertEclatant, 0.4f));
+        bool hov = layout.hovered(Widget::MENU_MODE, i);
+        out.rect(r, Fade(kVertEclatant, sel ? 0.3f : (hov ? 0.2f : 0.0f)));
+        out.rectLines(r, hov || sel ? 3 : 2,
+                      sel ? kVertEclatant : Fade(kVertEclatant, 0.4f));
+        out.textCentered(texts.get(modes[i], 20), {r.x + 35, r.y + 10},
+                         (hov || sel) ? WHITE : Fade(kVertEclatant, 0.4f));
     }
 
-    // Affichage interactif des notes de la gamme dans le menu
-    std::vector<std::string> menuNotes =
-        MusicUtils::getScaleNotesList(app.selectedScale_, app.selectedMode_);
-    std::string menuNotesStr = "Notes de la gamme :";
+    // Affichage interactif des notes de la gamme dans le menu, composé dans
+    // l'arène de l'image
+    std::pmr::memory_resource* arena = app.arena_.resource();
+    auto menuNotes = MusicUtils::getScaleNotesList(app.selectedScale_,
+                                                   app.selectedMode_, arena);
+    std::pmr::string menuNotesStr("Notes de la gamme :", arena);
     for (size_t idx = 0; idx < menuNotes.size(); ++idx) {
-        menuNotesStr += " " + MusicUtils::noteDisplayLabel(
-                                  menuNotes[idx], app.selectedNotation_);
+        menuNotesStr += ' ';
+        menuNotesStr += MusicUtils::noteDisplayLabel(
+            menuNotes[idx], app.selectedNotation_, arena);
         if (idx + 1 < menuNotes.size()) {
             menuNotesStr += "   ";
         }
     }
-    DrawText(menuNotesStr.c_str(),
-             (int)screenW / 2 - MeasureText(menuNotesStr.c_str(), 18) / 2,
-             (int)(screenH * 0.81f), 18, Fade(kVertEclatant, 0.8f));
+    out.textCentered(texts.get(menuNotesStr, 18),
+                     {screenW / 2, screenH * 0.81f}, Fade(kVertEclatant, 0.8f));
 
-    Rectangle btnBack = {screenW / 2.0f - 150.0f, screenH * 0.92f, 300.0f,
-                         30.0f};
-    (void)drawButton(btnBack, "CHANGER D'UTILISATEUR", GRAY, mouse, 15);
+    drawButton(out, texts, layout.rect(Widget::MENU_SWITCH_USER),
+               "CHANGER D'UTILISATEUR", GRAY,
+               layout.hovered(Widget::MENU_SWITCH_USER), 15);
 
     // Toggle clavier
-    Rectangle rKbd = {40, screenH - 80, 250, 40};
-    DrawRectangleLinesEx(rKbd, 2, app.showKeyboard_ ? kVertEclatant : GRAY);
-    DrawText(app.showKeyboard_ ? "CLAVIER : ON" : "CLAVIER : OFF",
-             (int)rKbd.x + 20, (int)rKbd.y + 10, 20,
-             app.showKeyboard_ ? kVertEclatant : GRAY);
+    Rectangle rKbd = layout.rect(Widget::MENU_KEYBOARD);
+    Color kbdColor = app.showKeyboard_ ? kVertEclatant : GRAY;
+    out.rectLines(rKbd, 2, kbdColor);
+    out.text(
+        texts.get(app.showKeyboard_ ? "CLAVIER : ON" : "CLAVIER : OFF", 20),
+        {rKbd.x + 20, rKbd.y + 10}, kbdColor);
+
+    // Toggle notes qui tombent
+    Rectangle rFall = layout.rect(Widget::MENU_FALLING);
+    Color fallColor = app.showFallingNotes_ ? kVertEclatant : GRAY;
+    out.rectLines(rFall, 2, fallColor);
+    out.text(
+        texts.get(app.showFallingNotes_ ? "CASCADE : ON" : "CASCADE : OFF", 20),
+        {rFall.x + 20, rFall.y + 10}, fallColor);
 
     // Toggle notation
-    Rectangle rNotation = {screenW - 290, screenH - 80, 250, 40};
+    Rectangle rNotation = layout.rect(Widget::MENU_NOTATION);
     const char* notationText =
         app.selectedNotation_ == NotationMode::SYLLABIC ? "NOTATION : DO RE MI"
         : app.selectedNotation_ == NotationMode::LETTER ? "NOTATION : A B C"
                                                         : "NOTATION : PORTEE";
-    DrawRectangleLinesEx(rNotation, 2, kVertEclatant);
-    DrawText(notationText, (int)rNotation.x + 20, (int)rNotation.y + 10, 20,
+    out.rectLines(rNotation, 2, kVertEclatant);
+    out.text(texts.get(notationText, 20), {rNotation.x + 20, rNotation.y + 10},
              kVertEclatant);
 }
 
-void UI::drawPlay(AppController& app, Vector2 mouse, float screenW,
+void UI::drawPlay(AppController& app, DrawList& out, float screenW,
                   float screenH) {
+    const PlayViewModel& view = app.playView_;
+    TextCache& texts = app.text_;
+    const Layout& layout = app.layout_;
     if (!app.isPaused_) {
-        // Zone de défi
-        Rectangle rChal = {screenW / 2.0f - 175.0f, screenH * 0.25f, 350.0f,
-                           200.0f};
+        // Notes qui tombent en fond, sous la zone de défi
+        if (app.showFallingNotes_) {
+            drawFallingNotes(out, app.falling_, app.keyboard_);
+        }
 
-        if (app.selectedNotation_ == NotationMode::STAFF &&
-            !app.currentChallenge_.expectedNotes.empty()) {
-            drawStaff(app, rChal, app.currentChallenge_.expectedNotes,
-                      kVertEclatant);
+        // Zone de défi
+        if (view.showStaff_) {
+            drawStaff(out, app.layers_[Layer::STAFF], texts,
+                      app.assets_.texture(ImageAsset::G_CLEF),
+                      view.challengeRect_, view.staffNotes_, kVertEclatant);
         } else {
-            DrawRectangleLinesEx(rChal, 3, kVertEclatant);
-            std::string display;
-            if (app.currentChallenge_.expectedNotes.empty()) {
-                display = "Attente…";
-            } else if (app.currentChallenge_.isChord) {
-                display = app.currentChallenge_.displayText;
-            } else {
-                display = MusicUtils::noteDisplayLabel(
-                    app.currentChallenge_.expectedNotes[0],
-                    app.selectedNotation_);
-            }
-            const char* chalTxt = display.c_str();
-            int txtSize = (display.size() > 8) ? 28 : 36;
-            DrawText(chalTxt,
-                     (int)screenW / 2 - MeasureText(chalTxt, txtSize) / 2,
-                     (int)rChal.y + 80, txtSize, kVertEclatant);
+            out.rectLines(view.challengeRect_, 3, kVertEclatant);
+            out.textCentered(
+                texts.get(view.challengeText_, view.challengeTextSize_),
+                view.challengeTextPos_, kVertEclatant);
         }
 
         if (app.feedbackAlpha_ > 0.0f) {
-            DrawText(app.feedbackMsg_,
-                     (int)screenW / 2 - MeasureText(app.feedbackMsg_, 40) / 2,
-                     (int)(screenH * 0.2f), 40,
-                     Fade(app.feedbackColor_, app.feedbackAlpha_));
+            out.textCentered(texts.get(view.feedback_, 40), view.feedbackPos_,
+                             Fade(app.feedbackColor_, app.feedbackAlpha_));
         }
 
-        Rectangle btnMenu = {25.0f, 25.0f, 120.0f, 45.0f};
-        (void)drawButton(btnMenu, "MENU", kVertEclatant, mouse);
+        drawButton(out, texts, layout.rect(Widget::PLAY_MENU), "MENU",
+                   kVertEclatant, layout.hovered(Widget::PLAY_MENU));
 
         if (app.engState_ == EngineState::ENG_PLAYED) {
-            Rectangle btnReady = {160.0f, 25.0f, 160.0f, 45.0f};
-            (void)drawButton(btnReady, "SUIVANT", kOrEclatant, mouse);
+            drawButton(out, texts, layout.rect(Widget::PLAY_NEXT), "SUIVANT",
+                       kOrEclatant, layout.hovered(Widget::PLAY_NEXT));
         }
 
-        // Affichage interactif des notes de la gamme active en jeu
-        std::vector<std::string> scaleNotes = MusicUtils::getScaleNotesList(
-            app.selectedScale_, app.selectedMode_);
-        std::string scaleNameStr =
-            "Gamme active : " +
-            MusicUtils::getScaleNameFormatted(
-                app.selectedScale_, app.selectedMode_, app.selectedNotation_);
-        DrawText(scaleNameStr.c_str(),
-                 (int)screenW / 2 - MeasureText(scaleNameStr.c_str(), 18) / 2,
-                 (int)(rChal.y + rChal.height + 15), 18,
-                 Fade(kVertEclatant, 0.7f));
-
-        float boxW = 50.0f;
-        float boxH = 40.0f;
-        float spacing = 12.0f;
-        float startX = screenW / 2.0f - (7.0f * boxW + 6.0f * spacing) / 2.0f;
-        float startY = rChal.y + rChal.height + 42.0f;
-
-        for (size_t i = 0; i < scaleNotes.size() && i < 7; ++i) {
-            const std::string& scaleNote = scaleNotes[i];
-            Rectangle boxRec = {startX + (float)i * (boxW + spacing), startY,
-                                boxW, boxH};
-
-            // Check if note is expected in the current challenge
-            bool isExpected = false;
-            for (const auto& n : app.currentChallenge_.expectedNotes) {
-                if (MusicUtils::isSameNoteClass(n, scaleNote)) {
-                    isExpected = true;
-                    break;
-                }
-            }
-
-            // Check if note is part of the last result correct/incorrect
-            bool isCorrect = false;
-            bool isIncorrect = false;
-            if (app.lastResult_.active) {
-                for (const auto& n : app.lastResult_.correct) {
-                    if (MusicUtils::isSameNoteClass(n, scaleNote)) {
-                        isCorrect = true;
-                        break;
-                    }
-                }
-                for (const auto& n : app.lastResult_.incorrect) {
-                    if (MusicUtils::isSameNoteClass(n, scaleNote)) {
-                        isIncorrect = true;
-                        break;
-                    }
-                }
-            }
-
-            // Check if note is currently pressed on virtual keyboard
-            bool isPressed = false;
-            if (app.showKeyboard_) {
-                int32_t baseKeyboardOctave = MusicUtils::getChallengeBaseOctave(
-                    app.currentChallenge_.expectedNotes);
-                int32_t numKeys = app.getSelectedGameKeys();
-                for (int k = 0; k < numKeys; k++) {
-                    if (app.blanchesAppuyees_[k]) {
-                        int octave = baseKeyboardOctave + (k / 7);
-                        std::string noteName =
-                            std::string(1, "cdefgab"[k % 7]) +
-                            std::to_string(octave);
-                        if (MusicUtils::isSameNoteClass(noteName, scaleNote)) {
-                            isPressed = true;
-                            break;
-                        }
-                    }
-                }
-                int32_t numBlack = (numKeys / 7) * 5;
-                for (int k = 0; k < numBlack; k++) {
-                    if (app.noiresAppuyees_[k]) {
-                        static constexpr char WHITE_LETTERS[7] = {
-                            'c', 'd', 'e', 'f', 'g', 'a', 'b'};
-                        int octave =
-                            baseKeyboardOctave + (app.kBlackKeyIndices[k] / 7);
-                        std::string sharpNote =
-                            std::string(
-                                1, WHITE_LETTERS[app.kBlackKeyIndices[k] % 7]) +
-                            "#" + std::to_string(octave);
-                        if (MusicUtils::isSameNoteClass(sharpNote, scaleNote)) {
-                            isPressed = true;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            bool hov = CheckCollisionPointRec(mouse, boxRec);
-
-            // Choose colors based on state
-            Color fillCol, borderCol, textCol;
-            if (isIncorrect) {
-                fillCol = Fade(kRougeErreur, 0.4f);
-                borderCol = kRougeErreur;
-                textCol = WHITE;
-            } else if (isCorrect) {
-                fillCol = Fade(kVertEclatant, 0.4f);
-                borderCol = kVertEclatant;
-                textCol = WHITE;
-            } else if (isExpected) {
-                fillCol = Fade(kOrangeNote, 0.4f);
-                borderCol = kOrangeNote;
-                textCol = WHITE;
-            } else if (isPressed) {
-                fillCol = Fade(app.profiles_[app.currentUserIdx_].color, 0.4f);
-                borderCol = app.profiles_[app.currentUserIdx_].color;
-                textCol = WHITE;
-            } else {
-                fillCol = Fade(kVertEclatant, hov ? 0.15f : 0.05f);
-                borderCol = hov ? WHITE : Fade(kVertEclatant, 0.3f);
-                textCol = hov ? WHITE : Fade(kVertEclatant, 0.7f);
-            }
-
-            DrawRectangleRec(boxRec, fillCol);
-            DrawRectangleLinesEx(boxRec, hov ? 3 : 2, borderCol);
-
-            std::string dispLabel =
-                MusicUtils::noteDisplayLabel(scaleNote, app.selectedNotation_);
-            int fontSz = (dispLabel.size() > 2) ? 14 : 18;
-            DrawText(dispLabel.c_str(),
-                     (int)(boxRec.x + boxRec.width / 2 -
-                           MeasureText(dispLabel.c_str(), fontSz) / 2),
-                     (int)(boxRec.y + boxRec.height / 2 - fontSz / 2), fontSz,
-                     textCol);
+        // Notes de la gamme active, état préparé par PlayViewModel
+        out.textCentered(texts.get(view.scaleTitle_, 18), view.scaleTitlePos_,
+                         Fade(kVertEclatant, 0.7f));
+        for (size_t i = 0; i < view.boxCount_; ++i) {
+            out.rect(view.boxRect_[i], view.boxFill_[i]);
+            out.rectLines(view.boxRect_[i], view.boxLineWidth_[i],
+                          view.boxBorder_[i]);
+        }
+        for (size_t i = 0; i < view.boxCount_; ++i) {
+            out.textCentered(texts.get(view.boxLabel_[i], view.boxFontSize_[i]),
+                             view.boxLabelPos_[i], view.boxText_[i]);
         }
 
-        DrawText(std::format("{}", app.scoreActuel_).c_str(),
-                 (int)screenW / 2 - 20, 45, 60, kVertEclatant);
+        out.text(texts.get(view.scoreText_, 60), view.scorePos_,
+                 kVertEclatant);
 
-        Rectangle btnPause = {screenW - 85.0f, 25.0f, 60.0f, 60.0f};
-        (void)drawButton(btnPause, "", kVertEclatant, mouse);
-        DrawRectangle((int)btnPause.x + 18, (int)btnPause.y + 18, 8, 24,
-                      kVertEclatant);
-        DrawRectangle((int)btnPause.x + 34, (int)btnPause.y + 18, 8, 24,
-                      kVertEclatant);
+        Rectangle btnPause = layout.rect(Widget::PLAY_PAUSE);
+        drawButton(out, texts, btnPause, "", kVertEclatant,
+                   layout.hovered(Widget::PLAY_PAUSE));
+        out.rect({btnPause.x + 18, btnPause.y + 18, 8, 24}, kVertEclatant);
+        out.rect({btnPause.x + 34, btnPause.y + 18, 8, 24}, kVertEclatant);
 
         if (app.showKeyboard_) {
-            drawVirtualKeyboard(app, screenW, screenH, mouse);
+            drawVirtualKeyboard(out, app.keyboard_,
+                                app.layers_[Layer::KEYBOARD], texts);
         }
+
+        // Effets du résultat par-dessus tout l'écran de jeu
+        drawEffects(out, texts, app.effects_);
     } else {
         // Overlay de Pause
-        DrawRectangle(0, 0, (int)screenW, (int)screenH, Fade(BLACK, 0.85f));
-        Rectangle mB = {screenW / 2.0f - 200.0f, screenH / 2.0f - 150.0f,
-                        400.0f, 300.0f};
-        DrawRectangleLinesEx(mB, 3, kVertEclatant);
-        DrawText("PAUSE", (int)screenW / 2 - 60, (int)screenH / 2 - 110, 40,
+        out.rect({0.0f, 0.0f, screenW, screenH}, Fade(BLACK, 0.85f));
+        out.rectLines(layout.rect(Widget::PAUSE_PANEL), 3, kVertEclatant);
+        out.text(texts.get("PAUSE", 40), {screenW / 2 - 60, screenH / 2 - 110},
                  kVertEclatant);
 
-        Rectangle btnResume = {screenW / 2.0f - 150.0f, screenH / 2.0f - 50.0f,
-                               300.0f, 60.0f};
-        Rectangle btnQuit = {screenW / 2.0f - 150.0f, screenH / 2.0f + 30.0f,
-                             300.0f, 60.0f};
-        (void)drawButton(btnResume, "REPRENDRE", kVertEclatant, mouse, 25);
-        (void)drawButton(btnQuit, "QUITTER", kRougeErreur, mouse, 25);
+        drawButton(out, texts, layout.rect(Widget::PAUSE_RESUME), "REPRENDRE",
+                   kVertEclatant, layout.hovered(Widget::PAUSE_RESUME), 25);
+        drawButton(out, texts, layout.rect(Widget::PAUSE_QUIT), "QUITTER",
+                   kRougeErreur, layout.hovered(Widget::PAUSE_QUIT), 25);
     }
 }
 
-void UI::drawGameOver(AppController& app, Vector2 mouse, float screenW,
+void UI::drawGameOver(AppController& app, DrawList& out, float screenW,
                       float screenH) {
-    DrawText("FIN DE PARTIE",
-             (int)screenW / 2 - MeasureText("FIN DE PARTIE", 40) / 2,
-             (int)(screenH * 0.15f), 40, kVertEclatant);
-    DrawText(
-        std::format("SCORE FINAL : {}", app.scoreActuel_).c_str(),
-        (int)screenW / 2 -
-            MeasureText(
-                std::format("SCORE FINAL : {}", app.scoreActuel_).c_str(), 30) /
-                2,
-        (int)(screenH * 0.3f), 30, kOrEclatant);
-
-    DrawText(std::format("Parfaits   : {} / {}", app.gameStats_.perfect,
-                         app.gameStats_.total)
-                 .c_str(),
-             (int)screenW / 2 - 130, (int)(screenH * 0.45f), 22, kVertEclatant);
-    DrawText(std::format("Partiels   : {} / {}", app.gameStats_.partial,
-                         app.gameStats_.total)
-                 .c_str(),
-             (int)screenW / 2 - 130, (int)(screenH * 0.5f), 22, kVertEclatant);
-    DrawText(std::format("Durée      : {} s", app.gameStats_.duration / 1000)
-                 .c_str(),
-             (int)screenW / 2 - 130, (int)(screenH * 0.55f), 22, kVertEclatant);
-
-    Rectangle btnBack = {screenW / 2.0f - 150.0f, screenH * 0.7f, 300.0f,
-                         55.0f};
-    (void)drawButton(btnBack, "RETOUR AU MENU", kVertEclatant, mouse, 22);
+    TextCache& texts = app.text_;
+    const GameStats& stats = app.gameStats_;
+    out.textCentered(texts.get("FIN DE PARTIE", 40),
+                     {screenW / 2, screenH * 0.15f}, kVertEclatant);
+    out.textCentered(texts.format(30, "SCORE FINAL : {}", app.scoreActuel_),
+                     {screenW / 2, screenH * 0.3f}, kOrEclatant);
+
+    float left = screenW / 2 - 130;
+    out.text(
+        texts.format(22, "Parfaits   : {} / {}", stats.perfect, stats.total),
+        {left, screenH * 0.45f}, kVertEclatant);
+    out.text(
+        texts.format(22, "Partiels   : {} / {}", stats.partial, stats.total),
+        {left, screenH * 0.5f}, kVertEclatant);
+    out.text(texts.format(22, "Durée      : {} s", stats.duration / 1000),
+             {left, screenH * 0.55f}, kVertEclatant);
+
+    const Layout& layout = app.layout_;
+    drawButton(out, texts, layout.rect(Widget::GAME_OVER_BACK),
+               "RETOUR AU MENU", kVertEclatant,
+               layout.hovered(Widget::GAME_OVER_BACK), 22);
 }
 
-void UI::drawVirtualKeyboard(AppController& app, float screenW, float screenH,
-                             Vector2 mouse) {
-    int32_t baseKeyboardOctave =
-        MusicUtils::getChallengeBaseOctave(app.currentChallenge_.expectedNotes);
-    int32_t numKeys = app.getSelectedGameKeys();
-    int32_t numBlack = (numKeys / 7) * 5;
-    float wW = screenW / (float)numKeys;
-    float pianoY = screenH * 0.7f;
-    float pianoH = screenH - pianoY;
-    float bW = wW * 0.6f;
-
-    int hovWhite = -1;
-    int hovBlack = -1;
-
-    if (!app.isPaused_ && mouse.y > pianoY) {
-        for (int i = 0; i < numBlack; i++) {
-            Rectangle rN = {(app.kBlackKeyIndices[i] + 1) * wW - bW / 2.0f,
-                            pianoY, bW, pianoH * 0.6f};
-            if (CheckCollisionPointRec(mouse, rN)) {
-                hovBlack = i;
-                break;
-            }
-        }
-        if (hovBlack == -1) {
-            hovWhite = (int)(mouse.x / wW);
-            if (hovWhite < 0 || hovWhite >= numKeys) {
-                hovWhite = -1;
-            }
+void UI::drawVirtualKeyboard(DrawList& out, const KeyboardModel& keyboard,
+                             CachedLayer& outlines, TextCache& texts) {
+    // Seules les touches de la fenêtre visible sont parcourues
+    int32_t firstWhite = keyboard.firstWhite_;
+    int32_t endWhite = keyboard.endWhite_;
+    int32_t firstBlack = keyboard.firstBlack_;
+    int32_t endBlack = keyboard.endBlack_;
+
+    // Remplissage des blanches marquées, sous les contours
+    for (int32_t i = firstWhite; i < endWhite; ++i) {
+        if (keyboard.whiteFill_[i].a != 0) {
+            out.rect(keyboard.whiteRect_[i], keyboard.whiteFill_[i]);
         }
     }
 
-    for (int i = 0; i < numKeys; i++) {
-        Rectangle r = {i * wW, pianoY, wW - 2.0f, pianoH};
-        int octave = baseKeyboardOctave + (i / 7);
-        std::string noteName =
-            std::string(1, "cdefgab"[i % 7]) + std::to_string(octave);
-        NoteKey nk = MusicUtils::resolveKey(noteName, baseKeyboardOctave);
-        bool isExpected = false, isCorrectKey = false, isWrongKey = false;
-
-        if (nk.valid && !nk.isBlack) {
-            for (const auto& n : app.currentChallenge_.expectedNotes) {
-                NoteKey ek = MusicUtils::resolveKey(n, baseKeyboardOctave);
-                if (ek.valid && !ek.isBlack && ek.index == nk.index) {
-                    isExpected = true;
-                }
-            }
-            if (app.lastResult_.active) {
-                for (const auto& n : app.lastResult_.correct) {
-                    NoteKey ck = MusicUtils::resolveKey(n, baseKeyboardOctave);
-                    if (ck.valid && !ck.isBlack && ck.index == nk.index) {
-                        isCorrectKey = true;
-                    }
-                }
-                for (const auto& n : app.lastResult_.incorrect) {
-                    NoteKey ik = MusicUtils::resolveKey(n, baseKeyboardOctave);
-                    if (ik.valid && !ik.isBlack && ik.index == nk.index) {
-                        isWrongKey = true;
-                    }
-                }
-            }
+    // Contours et noires au repos en cache, redessinés quand la fenêtre
+    // défile, zoome ou change de taille
+    Rectangle bounds = {0.0f, keyboard.screenH_ * 0.7f, keyboard.screenW_,
+                        keyboard.screenH_ * 0.3f};
+    LayerKey key;
+    key.add(keyboard.viewStart_).add(keyboard.keyWidth_);
+    key.add(keyboard.screenW_).add(keyboard.screenH_);
+    out.layer(outlines, bounds, key, [&] {
+        for (int32_t i = firstWhite; i < endWhite; ++i) {
+            out.rectLines(keyboard.whiteRect_[i], 2, kVertEclatant);
         }
-
-        Color keyColor =
-            isWrongKey     ? kRougeErreur
-            : isCorrectKey ? kVertEclatant
-            : isExpected   ? kOrangeNote
-            : app.blanchesAppuyees_[i]
-                ? app.profiles_[app.currentUserIdx_].color
-            : (hovWhite == i)
-                ? Fade(app.profiles_[app.currentUserIdx_].color, 0.3f)
-                : BLANK;
-
-        if (keyColor.a != 0) {
-            DrawRectangleRec(r, keyColor);
-        }
-        DrawRectangleLinesEx(
-            r, 2, app.isPaused_ ? Fade(kVertEclatant, 0.2f) : kVertEclatant);
-
-        if (numKeys <= 7) {
-            std::string label =
-                MusicUtils::getNotationLabel(i, app.selectedNotation_);
-            DrawText(
-                label.c_str(),
-                (int)r.x + (int)(wW / 2) - MeasureText(label.c_str(), 18) / 2,
-                (int)r.y + (int)pianoH - 30, 18,
-                app.isPaused_ ? Fade(kVertEclatant, 0.2f)
-                              : (keyColor.a != 0 ? kVertFonce : kVertEclatant));
+        for (int32_t i = firstBlack; i < endBlack; ++i) {
+            out.rect(keyboard.blackRect_[i], KeyboardModel::BLACK_FILL);
+            out.rectLines(keyboard.blackRect_[i], 2, kVertEclatant);
         }
+    });
+
+    // Noires marquées, survolées ou enfoncées par-dessus la couche
+    for (int32_t i = firstBlack; i < endBlack; ++i) {
+        if (keyboard.blackFlags_[i] == 0) continue;
+        out.rect(keyboard.blackRect_[i], keyboard.blackFill_[i]);
+        out.rectLines(keyboard.blackRect_[i], 2, kVertEclatant);
     }
 
-    for (int i = 0; i < numBlack; i++) {
-        Rectangle rN = {(app.kBlackKeyIndices[i] + 1) * wW - bW / 2.0f, pianoY,
-                        bW, pianoH * 0.6f};
-        static constexpr char WHITE_LETTERS[7] = {'c', 'd', 'e', 'f',
-                                                  'g', 'a', 'b'};
-        int octave = baseKeyboardOctave + (app.kBlackKeyIndices[i] / 7);
-        std::string sharpNote =
-            std::string(1, WHITE_LETTERS[app.kBlackKeyIndices[i] % 7]) + "#" +
-            std::to_string(octave);
-        bool bkExpected = false, bkCorrect = false, bkWrong = false;
-
-        for (const auto& n : app.currentChallenge_.expectedNotes) {
-            if (MusicUtils::noteInList(sharpNote, {n})) {
-                bkExpected = true;
-            }
+    // Lettres du clavier de l'ordinateur, sous les noires
+    if (keyboard.showHints_ && keyboard.hintBase_ >= 0) {
+        for (int32_t i = firstWhite; i < endWhite; ++i) {
+            if (keyboard.whiteHint_[i] == 0) continue;
+            out.textCentered(texts.get({&keyboard.whiteHint_[i], 1}, 16),
+                             keyboard.whiteHintPos_[i],
+                             Fade(keyboard.whiteText_[i], 0.6f));
         }
-        if (app.lastResult_.active) {
-            for (const auto& n : app.lastResult_.correct) {
-                if (MusicUtils::noteInList(sharpNote, {n})) {
-                    bkCorrect = true;
-                }
-            }
-            for (const auto& n : app.lastResult_.incorrect) {
-                if (MusicUtils::noteInList(sharpNote, {n})) {
-                    bkWrong = true;
-                }
-            }
+        for (int32_t i = firstBlack; i < endBlack; ++i) {
+            if (keyboard.blackHint_[i] == 0) continue;
+            out.textCentered(texts.get({&keyboard.blackHint_[i], 1}, 16),
+                             keyboard.blackHintPos_[i],
+                             Fade(kVertEclatant, 0.6f));
         }
+    }
+
+    if (!keyboard.showLabels_) return;
+    for (int32_t i = firstWhite; i < endWhite; ++i) {
+        out.textCentered(texts.get(keyboard.whiteLabel_[i], 18),
+                         keyboard.whiteLabelPos_[i], keyboard.whiteText_[i]);
+    }
+}
+
+void UI::drawFallingNotes(DrawList& out, const FallingNotes& notes,
+                          const KeyboardModel& keyboard) {
+    if (notes.count_ == 0 || keyboard.keyWidth_ <= 0.0f) return;
+    // Chute du haut de l'écran jusqu'au clavier, à la fenêtre du clavier
+    float land = keyboard.screenH_ * 0.7f;
+    float length = land * FallingNotes::LENGTH;
+    float unit = keyboard.keyWidth_;
+    float origin = keyboard.viewStart_;
+
+    // Quads consécutifs sur la texture des formes : un seul lot
+    for (size_t i = 0; i < notes.count_; ++i) {
+        float left = (notes.lane_[i] - origin) * unit + 1.0f;
+        float width = notes.width_[i] * unit - 2.0f;
+        if (left + width < 0.0f || left > keyboard.screenW_) continue;
+        float bottom = notes.fall_[i] * land;
+        out.solid({left, bottom - length, width, length},
+                  Fade(notes.color_[i], 0.85f * notes.life_[i]));
+    }
+}
 
-        Color bkFill =
-            bkWrong                  ? kRougeErreur
-            : bkCorrect              ? kVertEclatant
-            : bkExpected             ? kOrangeNote
-            : app.noiresAppuyees_[i] ? app.profiles_[app.currentUserIdx_].color
-            : (hovBlack == i)
-                ? Fade(app.profiles_[app.currentUserIdx_].color, 0.6f)
-            : app.isPaused_ ? Fade(DARKGRAY, 0.5f)
-                            : Color{30, 60, 30, 255};
-
-        DrawRectangleRec(rN, bkFill);
-        DrawRectangleLinesEx(
-            rN, 2, app.isPaused_ ? Fade(kVertEclatant, 0.2f) : kVertEclatant);
+void UI::drawEffects(DrawList& out, TextCache& texts,
+                     const ResultParticles& effects) {
+    // Quads consécutifs sur la texture des formes : un seul lot
+    for (size_t i = 0; i < effects.count_; ++i) {
+        out.solid(effects.rect(i), Fade(effects.color_[i], effects.life_[i]));
+    }
+    for (size_t i = 0; i < effects.popupCount_; ++i) {
+        out.textCentered(texts.get(effects.popupText_[i], 48),
+                         effects.popupPos_[i],
+                         Fade(effects.popupColor_[i], effects.popupLife_[i]));
+    }
+}
+
+void UI::drawProfiler(DrawList& out, const FrameProfiler& profiler,
+                      float screenW) {
+    constexpr float WIDTH{FrameProfiler::HISTORY * HUD_BAR_W + 20.0f};
+    Rectangle panel{screenW - WIDTH - 10.0f, 10.0f, WIDTH, 214.0f};
+    out.rect(panel, Fade(BLACK, 0.75f));
+    out.rectLines(panel, 1, Fade(RAYWHITE, 0.4f));
+
+    // Graphe glissant : étapes empilées, image la plus récente à droite
+    float left = panel.x + 10.0f;
+    float base = panel.y + 10.0f + HUD_GRAPH_H;
+    float scale = HUD_GRAPH_H / HUD_GRAPH_MS;
+    size_t count = profiler.count_;
+    size_t oldest =
+        (profiler.next_ + FrameProfiler::HISTORY - count) %
+        FrameProfiler::HISTORY;
+    for (size_t i = 0; i < count; ++i) {
+        const FrameSample& s =
+            profiler.history_[(oldest + i) % FrameProfiler::HISTORY];
+        float x = left + static_cast<float>(FrameProfiler::HISTORY - count +
+                                            i) * HUD_BAR_W;
+        float y = base;
+        for (size_t k = 0; k < s.sectionMs.size(); ++k) {
+            // Écrêté en haut du graphe
+            float h = std::min(s.sectionMs[k] * scale, y - panel.y - 10.0f);
+            y -= h;
+            out.rect({x, y, HUD_BAR_W, h}, HUD_COLORS[k]);
+        }
     }
+    float budget = base - 16.7f * scale; // Une image à 60 i/s
+    out.line({left, budget}, {left + WIDTH - 20.0f, budget}, 1, kRougeErreur);
+
+    const FrameStats& st = profiler.stats_;
+    const auto& mean = st.mean.sectionMs;
+    float textY = base + 8.0f;
+    drawHudLine(out, {left, textY},
+                "image p50 {:.1f}  p95 {:.1f}  p99 {:.1f}  max {:.1f} ms",
+                st.p50Ms, st.p95Ms, st.p99Ms, st.maxMs);
+    drawHudLine(out, {left, textY + 22.0f},
+                "msg {:.2f}  logique {:.2f}  rendu {:.2f}  swap {:.2f} ms",
+                mean[0], mean[1], mean[2], mean[3]);
+    drawHudLine(out, {left, textY + 44.0f},
+                "file {}  {} msg/s  {} alloc/image", profiler.queueDepth_,
+                profiler.messagesPerSecond_, st.mean.allocations);
+    const auto& allocs = st.mean.sectionAllocs;
+    drawHudLine(out, {left, textY + 66.0f},
+                "alloc msg {}  logique {}  rendu {}  swap {}", allocs[0],
+                allocs[1], allocs[2], allocs[3]);
+    drawHudLine(out, {left, textY + 88.0f},
+                "latence clavier {:.1f} ms  max {:.1f} ms", st.latencyMs,
+                st.latencyMaxMs);
 }
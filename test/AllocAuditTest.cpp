@@ -0,0 +1,86 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AllocCounter.hpp"
+#include "AppController.hpp"
+#include "Mocks.hpp"
+#include "ScriptedInput.hpp"
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace Mocks;
+
+namespace {
+/// Scénario qui relève les allocations du thread principal à chaque image
+class AuditedInput : public ScriptedInput {
+  public:
+    /// Image présentée : date et allocations depuis la précédente
+    struct Frame {
+        double time;
+        uint64_t allocations;
+    };
+
+  private:
+    std::vector<Frame> frames_;
+    uint64_t last_{0};
+
+  public:
+    AuditedInput() { this->frames_.reserve(4096); }
+
+    void present() override {
+        uint64_t count = AllocCounter::threadCount();
+        this->frames_.push_back({this->now(), count - this->last_});
+        this->last_ = count;
+        ScriptedInput::present();
+    }
+
+    /**
+     * @brief Images d'un intervalle de temps qui ont alloué
+     * @param from Début de l'intervalle
+     * @param to Fin de l'intervalle
+     * @param frames Images de l'intervalle, toutes comprises
+     * @return Images ayant alloué
+     */
+    size_t allocating(double from, double to, size_t& frames) const {
+        size_t count = 0;
+        frames = 0;
+        for (const Frame& f : this->frames_) {
+            if (f.time < from || f.time > to) continue;
+            ++frames;
+            if (f.allocations > 0) ++count;
+        }
+        return count;
+    }
+};
+} // namespace
+
+TEST_CASE("Aucune allocation par image en régime établi, du menu à la fin") {
+    AuditedInput script;
+    openGame(script, 3.0);
+    script.press(0.2, InputKey::PROFILER) // HUD : une image à chaque tour
+        .receive(3.1, Message("ack", {{"status", "ok"}}))
+        .receive(3.2, Message("note", {{"id", "1"}, {"note", "e4"}}))
+        .receive(6.0, Message("result", {{"correct", "e4"}}))
+        .receive(9.0, Message("over", {{"perfect", "1"},
+                                       {"partial", "0"},
+                                       {"total", "1"},
+                                       {"duration", "6000"}}))
+        .quitAt(12.0);
+
+    AppController app;
+    app.replay(script);
+
+    // Transitions exclues : chaque intervalle commence après un événement
+    struct Window {
+        const char* name;
+        double from;
+        double to;
+    };
+    for (Window w : {Window{"menu", 0.8, 2.8}, Window{"défi", 3.5, 5.5},
+                     Window{"résultat", 6.3, 8.3},
+                     Window{"fin de partie", 9.3, 11.8}}) {
+        CAPTURE(w.name);
+        size_t frames = 0;
+        size_t allocating = script.allocating(w.from, w.to, frames);
+        CHECK(frames > 60);
+        CHECK(allocating == 0);
+    }
+}
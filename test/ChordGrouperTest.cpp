@@ -0,0 +1,51 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "ChordGrouper.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("ChordGrouper regroupe les appuis d'une même fenêtre") {
+    ChordGrouper grouper;
+    Chord chord;
+    grouper.press(60, 1.00);
+    grouper.press(64, 1.02);
+    grouper.press(67, 1.04);
+    grouper.update(1.045);
+    CHECK_FALSE(grouper.pop(chord)); // Fenêtre encore ouverte
+
+    grouper.update(1.00 + ChordGrouper::WINDOW);
+    REQUIRE(grouper.pop(chord));
+    REQUIRE(chord.notes.size() == 3);
+    CHECK(chord.notes[0] == NotePress{60, 1.00});
+    CHECK(chord.notes[2] == NotePress{67, 1.04});
+    CHECK(chord.start() == 1.00);
+    CHECK_FALSE(grouper.pop(chord));
+}
+
+TEST_CASE("ChordGrouper sépare les appuis trop espacés") {
+    ChordGrouper grouper;
+    Chord chord;
+    grouper.press(60, 2.0);
+    grouper.press(60, 2.01); // Doublon ignoré
+    grouper.press(62, 2.2);  // Clôt le premier accord
+    grouper.update(3.0);
+
+    REQUIRE(grouper.pop(chord));
+    CHECK(chord.notes.size() == 1);
+    CHECK(chord.notes[0].midi == 60);
+    REQUIRE(grouper.pop(chord));
+    CHECK(chord.notes.size() == 1);
+    CHECK(chord.start() == 2.2);
+
+    grouper.press(64, 4.0);
+    grouper.clear();
+    grouper.update(5.0);
+    CHECK_FALSE(grouper.pop(chord));
+}
+
+TEST_CASE("ChordGrouper indique le délai avant clôture") {
+    ChordGrouper grouper;
+    CHECK(grouper.timeLeft(1.0) == 0.0);
+    grouper.press(60, 1.0);
+    CHECK(grouper.timeLeft(1.02) ==
+          doctest::Approx(ChordGrouper::WINDOW - 0.02));
+    CHECK(grouper.timeLeft(2.0) == 0.0);
+}
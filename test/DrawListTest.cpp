@@ -0,0 +1,141 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AllocCounter.hpp"
+#include "DrawList.hpp"
+#include "FramePipeline.hpp"
+#include <doctest/doctest.h>
+#include <thread>
+
+namespace {
+/**
+ * @brief Texte préparé de deux glyphes sur un atlas fictif
+ * @param font Police portant l'identifiant de l'atlas
+ * @return Texte préparé
+ */
+TextRun twoGlyphs(const Font& font) {
+    TextRun run;
+    run.font = &font;
+    run.quads = {{0.0f, 0.0f, 0.5f, 0.5f, {0.0f, 0.0f, 8.0f, 10.0f}},
+                 {0.5f, 0.0f, 1.0f, 0.5f, {8.0f, 0.0f, 8.0f, 10.0f}}};
+    run.width = 16.0f;
+    return run;
+}
+} // namespace
+
+TEST_CASE("Textes consécutifs sur un même atlas : un seul lot de quads") {
+    Font font{};
+    font.texture.id = 7;
+    TextRun run = twoGlyphs(font);
+
+    DrawList list;
+    list.text(run, {10.6f, 20.2f}, WHITE);
+    list.textCentered(run, {100.0f, 40.0f}, RED);
+    REQUIRE(list.commands().size() == 1);
+    CHECK(list.commands()[0].op == DrawOp::QUADS);
+    CHECK(list.commands()[0].count == 4);
+    // Positions entières, comme DrawText
+    CHECK(list.quads()[0].dest.x == 10.0f);
+    CHECK(list.quads()[1].dest.x == 18.0f);
+    CHECK(list.quads()[2].dest.x == 92.0f);
+
+    // Une forme intercalée coupe le lot
+    list.rect({0.0f, 0.0f, 4.0f, 4.0f}, BLUE);
+    list.text(run, {0.0f, 0.0f}, WHITE);
+    CHECK(list.commands().size() == 3);
+    CHECK(list.quads().size() == 6);
+
+    list.clear();
+    CHECK(list.commands().empty());
+    CHECK(list.quads().empty());
+}
+
+TEST_CASE("Le contenu d'une couche n'est enregistré que s'il a changé") {
+    Font font{};
+    font.texture.id = 7;
+    TextRun run = twoGlyphs(font);
+    CachedLayer layer;
+    Rectangle bounds{0.0f, 0.0f, 100.0f, 50.0f};
+    DrawList list;
+    int renders = 0;
+    auto frame = [&](uint64_t value) {
+        list.clear();
+        LayerKey key;
+        key.add(value);
+        list.layer(layer, bounds, key, [&] {
+            ++renders;
+            list.text(run, {0.0f, 0.0f}, WHITE);
+        });
+        list.text(run, {0.0f, 30.0f}, WHITE); // Hors de la couche
+    };
+
+    frame(1);
+    CHECK(renders == 1);
+    REQUIRE(list.commands().size() == 3);
+    CHECK(list.commands()[0].op == DrawOp::LAYER);
+    CHECK(list.commands()[0].count == 1);
+    CHECK(list.commands()[1].count == 2); // Non fusionné avec la suite
+    CHECK(list.commands()[2].count == 2);
+
+    frame(1);
+    CHECK(renders == 1);
+    CHECK(list.commands().size() == 2);
+    CHECK(list.commands()[0].count == 0);
+
+    frame(2);
+    CHECK(renders == 2);
+    layer.invalidate(); // Texture perdue : contenu redemandé
+    frame(2);
+    CHECK(renders == 3);
+}
+
+TEST_CASE("Enregistrement sur un thread dédié, en double tampon") {
+    FramePipeline frames;
+    int frame = 0;
+    std::thread::id recorder;
+    const DrawList* lists[2]{};
+    frames.setRecorder([&](DrawList& out) {
+        recorder = std::this_thread::get_id();
+        lists[frame % 2] = &out;
+        out.rect({static_cast<float>(frame), 0.0f, 1.0f, 1.0f}, WHITE);
+    });
+    frames.start({});
+    REQUIRE(frames.threaded());
+
+    CHECK_FALSE(frames.ready());
+    for (frame = 0; frame < 4; ++frame) {
+        frames.record();
+        frames.wait();
+        CHECK(frames.ready());
+    }
+    CHECK(recorder != std::this_thread::get_id());
+    CHECK(lists[0] != lists[1]);
+
+    // Sans thread : enregistrement sur place
+    frames.stop();
+    CHECK_FALSE(frames.threaded());
+    frames.record();
+    CHECK(recorder == std::this_thread::get_id());
+    CHECK(frames.ready());
+}
+
+TEST_CASE("Une liste réchauffée s'enregistre sans allocation") {
+    Font font{};
+    font.texture.id = 7;
+    TextRun run = twoGlyphs(font);
+    CachedLayer layer;
+    FramePipeline frames;
+    uint64_t key = 0;
+    frames.setRecorder([&](DrawList& out) {
+        for (int i = 0; i < 50; ++i) {
+            out.rect({0.0f, 0.0f, 4.0f, 4.0f}, BLUE);
+            out.text(run, {0.0f, static_cast<float>(i)}, WHITE);
+        }
+        out.layer(layer, {0.0f, 0.0f, 10.0f, 10.0f}, LayerKey().add(key),
+                  [&] { out.rectLines({0.0f, 0.0f, 10.0f, 10.0f}, 2, RED); });
+        out.plainText("p50 16.7 ms", {0.0f, 0.0f}, 16, WHITE);
+    });
+    for (int i = 0; i < 2; ++i) frames.record(); // Les deux listes
+
+    uint64_t before = AllocCounter::threadCount();
+    for (key = 1; key < 30; ++key) frames.record();
+    CHECK(AllocCounter::threadCount() == before);
+}
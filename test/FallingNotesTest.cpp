@@ -0,0 +1,58 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AllocCounter.hpp"
+#include "FallingNotes.hpp"
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+TEST_CASE("Les notes d'un défi tombent puis attendent le résultat") {
+    FallingNotes notes;
+    notes.setChallenge({"c4", "e4", "g4", "c9"}, WHITE); // c9 hors du piano
+    CHECK(notes.count() == 3);
+
+    CHECK(notes.animate(FallingNotes::FALL_TIME / 2.0f));
+    CHECK(notes.animate(FallingNotes::FALL_TIME)); // Arrivée au clavier
+    // Posées sur le clavier sans résultat : plus rien ne bouge
+    CHECK_FALSE(notes.animate(0.1f));
+    CHECK(notes.count() == 3);
+}
+
+TEST_CASE("Le résultat éteint les notes, fausses notes comprises") {
+    FallingNotes notes;
+    notes.setChallenge({"c4", "e4", "g4"}, WHITE);
+    notes.setResult({"c4", "e4"}, {"f4"});
+    CHECK(notes.count() == 4);
+
+    CHECK(notes.animate(FallingNotes::FADE_TIME / 2.0f));
+    CHECK(notes.count() == 4);
+    (void)notes.animate(FallingNotes::FADE_TIME);
+    CHECK(notes.count() == 0);
+}
+
+TEST_CASE("Un nouveau défi éteint les notes restées sans résultat") {
+    FallingNotes notes;
+    notes.setChallenge({"c4"}, WHITE);
+    notes.setChallenge({"d4", "f4"}, WHITE);
+    (void)notes.animate(FallingNotes::FADE_TIME * 1.01f);
+    CHECK(notes.count() == 2);
+}
+
+TEST_CASE("Réserve fixe : pleine, elle refuse sans allouer") {
+    FallingNotes notes;
+    std::vector<std::string> chord{"c4", "e4", "g4", "bb4"};
+    while (notes.count() < FallingNotes::CAPACITY) {
+        notes.setResult({}, chord); // Fausses notes : aucune en attente
+    }
+    CHECK(notes.count() == FallingNotes::CAPACITY);
+    notes.setResult({}, chord);
+    CHECK(notes.dropped() == chord.size());
+
+    uint64_t before = AllocCounter::threadCount();
+    for (int i = 0; i < 60; ++i) (void)notes.animate(1.0f / 60.0f);
+    CHECK(AllocCounter::threadCount() == before);
+    CHECK(notes.count() == 0);
+
+    notes.clear();
+    notes.setChallenge(chord, WHITE);
+    CHECK(notes.count() == chord.size());
+}
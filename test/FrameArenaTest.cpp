@@ -0,0 +1,84 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AllocCounter.hpp"
+#include "FrameArena.hpp"
+#include "MusicUtils.hpp"
+#include <doctest/doctest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+/**
+ * @brief Compose la ligne des notes de la gamme comme le menu
+ * @param arena Arène de l'image
+ * @return Longueur de la ligne
+ */
+size_t scaleLine(FrameArena& arena) {
+    std::pmr::memory_resource* resource = arena.resource();
+    auto notes = MusicUtils::getScaleNotesList(
+        ScaleChoice::SCALE_E, ModeChoice::MODE_MAJ, resource);
+    std::pmr::string line("Notes de la gamme :", resource);
+    for (const auto& note : notes) {
+        line += ' ';
+        line += MusicUtils::noteDisplayLabel(note, NotationMode::SYLLABIC,
+                                             resource);
+    }
+    return line.size();
+}
+} // namespace
+
+TEST_CASE("Libellés dans l'arène identiques aux libellés sur le tas") {
+    FrameArena arena;
+    for (const char* note : {"c4", "c#4", "eb4", "g", "h2", ""}) {
+        for (NotationMode mode :
+             {NotationMode::SYLLABIC, NotationMode::LETTER}) {
+            auto label =
+                MusicUtils::noteDisplayLabel(note, mode, arena.resource());
+            CHECK(std::string_view(label) ==
+                  MusicUtils::noteDisplayLabel(std::string(note), mode));
+        }
+    }
+    auto notes = MusicUtils::getScaleNotesList(
+        ScaleChoice::SCALE_F, ModeChoice::MODE_MAJ, arena.resource());
+    auto heap = MusicUtils::getScaleNotesList(ScaleChoice::SCALE_F,
+                                              ModeChoice::MODE_MAJ);
+    REQUIRE(notes.size() == heap.size());
+    for (size_t i = 0; i < notes.size(); ++i) {
+        CHECK(std::string_view(notes[i]) == heap[i]);
+    }
+    CHECK(notes.get_allocator().resource() == arena.resource());
+}
+
+TEST_CASE("Une image réchauffée n'alloue rien sur le tas") {
+    FrameArena arena;
+    const std::vector<std::string> chord{"a4", "c#4", "e4"};
+    arena.reset();
+    (void)scaleLine(arena);
+
+    size_t hits = 0;
+    uint64_t before = AllocCounter::threadCount();
+    for (int frame = 0; frame < 100; ++frame) {
+        arena.reset();
+        hits += scaleLine(arena) > 19 ? 1 : 0;
+        hits += MusicUtils::noteInList("c#5", chord) ? 1 : 0;
+        hits += MusicUtils::isSameNoteClass("Eb3", "eb") ? 1 : 0;
+    }
+    CHECK(AllocCounter::threadCount() == before);
+    CHECK(hits == 300);
+}
+
+TEST_CASE("Un débordement agrandit le tampon à la remise à zéro") {
+    FrameArena arena(256);
+    {
+        std::pmr::vector<int> big(arena.resource());
+        big.resize(1000); // Pris sur le tas
+    }
+    CHECK(arena.capacity() == 256);
+    arena.reset();
+    CHECK(arena.capacity() >= 256 + 1000 * sizeof(int));
+
+    uint64_t before = AllocCounter::threadCount();
+    std::pmr::vector<int> again(arena.resource());
+    again.resize(1000);
+    CHECK(AllocCounter::threadCount() == before);
+}
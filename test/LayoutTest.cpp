@@ -0,0 +1,84 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "Layout.hpp"
+#include <doctest/doctest.h>
+
+namespace {
+constexpr float W{1024.0f};
+constexpr float H{768.0f};
+
+/**
+ * @brief Centre d'un rectangle
+ * @return Point au milieu du rectangle
+ */
+Vector2 center(Rectangle r) {
+    return {r.x + r.width / 2.0f, r.y + r.height / 2.0f};
+}
+} // namespace
+
+TEST_CASE("Layout recalcule seulement quand ses entrées changent") {
+    Layout layout;
+    LayoutInputs inputs{AppState::MENU, W, H, 1, 2, false};
+    CHECK(layout.update(inputs) == true);
+    CHECK(layout.update(inputs) == false);
+    inputs.screenW = 800.0f;
+    CHECK(layout.update(inputs) == true);
+    inputs.games = 3;
+    CHECK(layout.update(inputs) == true);
+    CHECK(layout.rect(Widget::MENU_GAME, 2).width == 500.0f);
+    CHECK(layout.rect(Widget::MENU_GAME, 3).width == 0.0f);
+}
+
+TEST_CASE("Layout touche le même rectangle que celui dessiné") {
+    Layout layout;
+    (void)layout.update({AppState::MENU, W, H, 1, 2, false});
+
+    // Bouton clavier : même largeur au dessin et au clic
+    Rectangle kbd = layout.rect(Widget::MENU_KEYBOARD);
+    CHECK(kbd.width == 250.0f);
+    CHECK(layout.hitTest({kbd.x + 240.0f, kbd.y + 20.0f}) ==
+          Hit{Widget::MENU_KEYBOARD, 0});
+
+    for (int32_t i = 0; i < 7; ++i) {
+        Rectangle scale = layout.rect(Widget::MENU_SCALE, i);
+        CHECK(layout.hitTest(center(scale)) == Hit{Widget::MENU_SCALE, i});
+    }
+    Rectangle game = layout.rect(Widget::MENU_GAME, 1);
+    CHECK(layout.hitTest(center(game)) == Hit{Widget::MENU_GAME, 1});
+    CHECK(layout.hitTest({W / 2.0f, 5.0f}) == Hit{});
+    CHECK(layout.hitTest({-50.0f, H + 50.0f}) == Hit{});
+
+    layout.setPointer(center(game));
+    CHECK(layout.hovered(Widget::MENU_GAME, 1));
+    CHECK_FALSE(layout.hovered(Widget::MENU_GAME, 0));
+}
+
+TEST_CASE("Layout donne la priorité à l'élément du dessus") {
+    Layout layout;
+    (void)layout.update({AppState::PROFILE_SELECT, W, H, 2, 0, false});
+    Rectangle card = layout.rect(Widget::PROFILE_CARD, 1);
+    Rectangle del = layout.rect(Widget::PROFILE_DELETE, 1);
+    CHECK(layout.hitTest(center(del)) == Hit{Widget::PROFILE_DELETE, 1});
+    CHECK(layout.hitTest(center(card)) == Hit{Widget::PROFILE_CARD, 1});
+    CHECK(layout.hitTest(center(layout.rect(Widget::PROFILE_ADD))) ==
+          Hit{Widget::PROFILE_ADD, 0});
+
+    // Quatre profils : plus de carte d'ajout
+    (void)layout.update({AppState::PROFILE_SELECT, W, H, 4, 0, false});
+    CHECK(layout.rect(Widget::PROFILE_ADD).width == 0.0f);
+}
+
+TEST_CASE("Layout masque les boutons de jeu sous la pause") {
+    Layout layout;
+    (void)layout.update({AppState::PLAY, W, H, 1, 1, false});
+    Rectangle menu = layout.rect(Widget::PLAY_MENU);
+    CHECK(layout.hitTest(center(menu)) == Hit{Widget::PLAY_MENU, 0});
+
+    (void)layout.update({AppState::PLAY, W, H, 1, 1, true});
+    CHECK(layout.hitTest(center(menu)) == Hit{});
+    CHECK(layout.hitTest(center(layout.rect(Widget::PAUSE_QUIT))) ==
+          Hit{Widget::PAUSE_QUIT, 0});
+    CHECK(layout.hitTest({W / 2.0f, H / 2.0f - 140.0f}) ==
+          Hit{Widget::PAUSE_PANEL, 0});
+    CHECK(layout.hitTest(center(layout.rect(Widget::PLAY_PAUSE))) ==
+          Hit{Widget::PLAY_PAUSE, 0});
+}
@@ -1,4 +1,66 @@
 #ifndef MOCKS_HPP
 #define MOCKS_HPP
 
+#include "Layout.hpp"
+#include "Message.hpp"
+#include "ScriptedInput.hpp"
+#include "Types.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Scénarios rejoués par les tests et les bancs de mesure
+
+namespace Mocks {
+constexpr float W{1280.0f}; ///< Largeur de la fenêtre simulée
+constexpr float H{800.0f};  ///< Hauteur de la fenêtre simulée
+
+/**
+ * @brief Centre d'un élément de l'écran, tel que l'application le placera
+ * @param inputs Écran et contenu
+ * @param widget Élément visé
+ * @param index Rang de l'élément
+ * @return Point à cliquer
+ */
+inline Vector2 centre(const LayoutInputs& inputs, Widget widget,
+                      int32_t index = 0) {
+    Layout layout;
+    layout.update(inputs);
+    Rectangle r = layout.rect(widget, index);
+    return {r.x + r.width / 2.0f, r.y + r.height / 2.0f};
+}
+
+/**
+ * @brief Types des messages envoyés au moteur
+ * @param script Scénario rejoué
+ * @return Types, dans l'ordre d'envoi
+ */
+inline std::vector<std::string> sentTypes(const ScriptedInput& script) {
+    std::vector<std::string> types;
+    for (const Message& msg : script.sent()) types.push_back(msg.getType());
+    return types;
+}
+
+/**
+ * @brief Début commun : un jeu annoncé, choix du profil, lancement du jeu
+ * @param script Scénario à compléter
+ * @param launch Date du lancement du jeu
+ * @param gametype Jeu annoncé par le moteur
+ * @return Date du lancement du jeu
+ */
+inline double openGame(ScriptedInput& script, double launch = 1.0,
+                       Message gametype = Message("gametype",
+                                                  {{"id", "note"},
+                                                   {"name", "Notes isolées"},
+                                                   {"keys", "7"}})) {
+    script.resize(0.0, W, H)
+        .receive(0.1, std::move(gametype))
+        .click(0.5, centre({AppState::PROFILE_SELECT, W, H, 1, 1},
+                           Widget::PROFILE_CARD))
+        .click(launch,
+               centre({AppState::MENU, W, H, 1, 1}, Widget::MENU_GAME));
+    return launch;
+}
+} // namespace Mocks
+
 #endif // MOCKS_HPP
@@ -0,0 +1,104 @@
+#include "MusicUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<uint64_t> allocations{0}; ///< Allocations depuis le lancement
+volatile int64_t sink{0}; ///< Empêche l'élimination des appels mesurés
+
+/// Accords réalistes (triades, renversements, septièmes) sur 3 octaves
+const std::vector<std::vector<std::string>> CHORDS{
+    {"c4", "e4", "g4"},        {"e4", "g4", "c5"},
+    {"g3", "c4", "e4"},        {"d4", "f#4", "a4"},
+    {"f#4", "a4", "d5"},       {"a3", "c#4", "e4"},
+    {"eb4", "g4", "bb4"},      {"c4", "eb4", "g4"},
+    {"ab3", "c4", "eb4"},      {"bb3", "d4", "f4"},
+    {"g3", "b3", "d4", "f4"},  {"d4", "f#4", "a4", "c5"},
+    {"c#5", "e5", "g#5"},      {"f3", "ab3", "c4", "eb4"},
+    {"b3", "d#4", "f#4", "a4"}};
+
+/**
+ * @brief Mesure une fonction, en temps et en allocations par appel
+ * @param name Nom affiché
+ * @param calls Nombre d'appels effectués par `fn` à chaque passe
+ * @param fn Fonction exécutant une passe, renvoyant une valeur à conserver
+ */
+template <typename Fn>
+void bench(const char* name, uint64_t calls, Fn&& fn) {
+    constexpr int PASSES = 2000;
+    for (int i = 0; i < 50; ++i) sink = sink + fn(); // Échauffement
+    uint64_t allocBefore = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PASSES; ++i) sink = sink + fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocs = allocations.load() - allocBefore;
+    double total = static_cast<double>(calls) * PASSES;
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::println("{:<24} {:>10.1f} ns/appel {:>8.2f} alloc/appel", name,
+                 ns / total, static_cast<double>(allocs) / total);
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    using namespace MusicUtils;
+    uint64_t noteCount = 0;
+    for (const auto& chord : CHORDS) noteCount += chord.size();
+    const auto scale =
+        getScaleNotesList(ScaleChoice::SCALE_C, ModeChoice::MODE_MAJ);
+
+    std::println("MusicUtils, {} accords / {} notes par passe", CHORDS.size(),
+                 noteCount);
+    bench("resolveKey", noteCount, [&] {
+        int64_t acc = 0;
+        for (const auto& chord : CHORDS) {
+            for (const auto& n : chord) acc += resolveKey(n, 4).index;
+        }
+        return acc;
+    });
+    bench("getChallengeBaseOctave", CHORDS.size(), [&] {
+        int64_t acc = 0;
+        for (const auto& chord : CHORDS) acc += getChallengeBaseOctave(chord);
+        return acc;
+    });
+    bench("isSameNoteClass", noteCount * scale.size(), [&] {
+        int64_t acc = 0;
+        for (const auto& chord : CHORDS) {
+            for (const auto& n : chord) {
+                for (const auto& s : scale) acc += isSameNoteClass(n, s);
+            }
+        }
+        return acc;
+    });
+    bench("noteInList", noteCount, [&] {
+        int64_t acc = 0;
+        for (const auto& chord : CHORDS) {
+            for (const auto& n : chord) acc += noteInList(n, chord);
+        }
+        return acc;
+    });
+    bench("spellNotes", CHORDS.size(), [&] {
+        int64_t acc = 0;
+        for (const auto& chord : CHORDS) {
+            acc += static_cast<int64_t>(
+                spellNotes(chord, ScaleChoice::SCALE_C, ModeChoice::MODE_MIN)
+                    .size());
+        }
+        return acc;
+    });
+    return 0;
+}
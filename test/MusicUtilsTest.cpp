@@ -0,0 +1,259 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "MusicUtils.hpp"
+#include <array>
+#include <cctype>
+#include <doctest/doctest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+constexpr std::array<std::string_view, 7> LETTERS{"c", "d", "e", "f",
+                                                  "g", "a", "b"};
+constexpr std::array<std::string_view, 6> ACCIDENTALS{"",   "#",  "b",
+                                                      "##", "bb", "x"};
+
+/**
+ * @brief Génère toutes les orthographes de notes (lettre, altération), sans
+ * octave puis pour chaque octave de 0 à 8
+ * @param accidentals Nombre d'altérations de `ACCIDENTALS` à utiliser
+ * @return Notes générées
+ */
+std::vector<std::string> allNotes(size_t accidentals = ACCIDENTALS.size()) {
+    std::vector<std::string> notes;
+    for (std::string_view letter : LETTERS) {
+        for (size_t a = 0; a < accidentals; ++a) {
+            std::string base(letter);
+            base += ACCIDENTALS[a];
+            notes.push_back(base);
+            for (int octave = 0; octave <= 8; ++octave) {
+                notes.push_back(base + std::to_string(octave));
+            }
+        }
+    }
+    return notes;
+}
+} // namespace
+
+/// Implémentations d'origine (chaînes), référence des propriétés ci-dessous
+namespace reference {
+
+NoteKey resolveKey(const std::string& note, int32_t baseKeyboardOctave) {
+    if (note.empty()) return {};
+    char letter = note[0];
+    size_t i = 1;
+    std::string mod;
+    if (i < note.size() && (note[i] == '#' || note[i] == 'b')) {
+        mod = note[i];
+        ++i;
+    }
+    int32_t octave = 4;
+    if (i < note.size() && std::isdigit(static_cast<unsigned char>(note[i]))) {
+        octave = note[i] - '0';
+    }
+    static constexpr int32_t WHITE_MAP[7] = {5, 6, 0, 1, 2, 3, 4};
+    if (letter < 'a' || letter > 'g') return {};
+    int32_t whiteIdx = WHITE_MAP[static_cast<int>(letter - 'a')];
+    whiteIdx += (octave - baseKeyboardOctave) * 7;
+    int32_t octaveOffset = 0;
+    if (whiteIdx < 0) {
+        octaveOffset = (whiteIdx - 6) / 7;
+        whiteIdx -= octaveOffset * 7;
+    }
+    if (mod.empty()) return {false, whiteIdx + octaveOffset * 7, true};
+    int32_t bkWhiteIdx = whiteIdx;
+    if (mod == "b") {
+        bkWhiteIdx -= 1;
+        if (bkWhiteIdx < 0) {
+            bkWhiteIdx += 7;
+            octaveOffset -= 1;
+        }
+    }
+    static const int32_t WHITE_TO_BLACK[7] = {0, 1, -1, 2, 3, 4, -1};
+    int32_t bkLocal = WHITE_TO_BLACK[bkWhiteIdx % 7];
+    if (bkLocal < 0) return {};
+    return {true, (bkWhiteIdx / 7) * 5 + bkLocal + octaveOffset * 5, true};
+}
+
+int32_t getChallengeBaseOctave(const std::vector<std::string>& expectedNotes) {
+    if (expectedNotes.empty()) return 4;
+    int32_t minOctave = 9;
+    for (const auto& note : expectedNotes) {
+        if (note.empty()) continue;
+        char lastChar = note.back();
+        if (std::isdigit(static_cast<unsigned char>(lastChar))) {
+            int32_t oct = lastChar - '0';
+            if (oct < minOctave) minOctave = oct;
+        }
+    }
+    return minOctave == 9 ? 4 : minOctave;
+}
+
+bool isSameNoteClass(const std::string& a, const std::string& b) {
+    auto clean = [](const std::string& s) {
+        std::string r;
+        for (char c : s) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) {
+                r += static_cast<char>(
+                    std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+        return r;
+    };
+    return clean(a) == clean(b);
+}
+
+bool noteInList(const std::string& noteBase,
+                const std::vector<std::string>& list) {
+    auto strip = [](const std::string& n) {
+        if (n.empty()) return n;
+        std::string s(1, n[0]);
+        if (n.size() > 1 && (n[1] == '#' || n[1] == 'b')) s += n[1];
+        return s;
+    };
+    std::string base = strip(noteBase);
+    for (const auto& n : list) {
+        if (strip(n) == base) return true;
+    }
+    return false;
+}
+
+} // namespace reference
+
+TEST_CASE("resolveKey identique à la référence") {
+    const auto notes = allNotes();
+    size_t mismatches = 0;
+    for (const auto& note : notes) {
+        for (int32_t base = 0; base <= 8; ++base) {
+            NoteKey got = MusicUtils::resolveKey(note, base);
+            NoteKey want = reference::resolveKey(note, base);
+            if (got.valid != want.valid || got.isBlack != want.isBlack ||
+                got.index != want.index) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(MusicUtils::resolveKey("", 4).valid == false);
+    CHECK(MusicUtils::resolveKey("h4", 4).valid == false);
+}
+
+TEST_CASE("resolveKey cohérent avec la hauteur MIDI") {
+    // Altérations simples seulement, seules envoyées par le moteur
+    const auto notes = allNotes(3);
+    for (const auto& a : notes) {
+        NoteKey ka = MusicUtils::resolveKey(a, 4);
+        if (!ka.valid) continue;
+        // Touches noires : enharmoniques sur la même touche (c#4 = db4)
+        for (const auto& b : notes) {
+            NoteKey kb = MusicUtils::resolveKey(b, 4);
+            if (!kb.valid || ka.isBlack != kb.isBlack) continue;
+            bool sameKey = ka.index == kb.index;
+            bool samePitch =
+                MusicUtils::midiNumber(a) == MusicUtils::midiNumber(b);
+            if (sameKey != samePitch) {
+                FAIL("Touche et hauteur incohérentes : " << a << " / " << b);
+            }
+        }
+    }
+}
+
+TEST_CASE("isSameNoteClass identique à la référence") {
+    const auto notes = allNotes();
+    size_t mismatches = 0;
+    for (const auto& a : notes) {
+        CHECK(MusicUtils::isSameNoteClass(a, a)); // Réflexivité
+        for (const auto& b : notes) {
+            bool got = MusicUtils::isSameNoteClass(a, b);
+            if (got != reference::isSameNoteClass(a, b)) ++mismatches;
+            if (got != MusicUtils::isSameNoteClass(b, a)) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(MusicUtils::isSameNoteClass("C#4", "c#") == true);
+}
+
+TEST_CASE("noteInList identique à la référence") {
+    const auto notes = allNotes();
+    size_t mismatches = 0;
+    for (const auto& note : notes) {
+        if (MusicUtils::noteInList(note, {}) != false) ++mismatches;
+        // Fenêtres glissantes de 3 notes, comme un accord
+        for (size_t i = 0; i + 3 <= notes.size(); ++i) {
+            std::vector<std::string> chord(notes.begin() + i,
+                                           notes.begin() + i + 3);
+            if (MusicUtils::noteInList(note, chord) !=
+                reference::noteInList(note, chord)) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(MusicUtils::noteInList("", {""}) == true);
+}
+
+TEST_CASE("getChallengeBaseOctave identique à la référence") {
+    const auto notes = allNotes();
+    size_t mismatches = 0;
+    for (const auto& a : notes) {
+        if (MusicUtils::getChallengeBaseOctave({a}) !=
+            reference::getChallengeBaseOctave({a})) {
+            ++mismatches;
+        }
+        for (const auto& b : notes) {
+            std::vector<std::string> pair{a, b};
+            if (MusicUtils::getChallengeBaseOctave(pair) !=
+                reference::getChallengeBaseOctave(pair)) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(MusicUtils::getChallengeBaseOctave({"", "c3"}) == 3);
+}
+
+TEST_CASE("spellNote conserve la hauteur pour toute gamme") {
+    const auto notes = allNotes();
+    for (int s = 0; s < 7; ++s) {
+        for (auto m : {ModeChoice::MODE_MAJ, ModeChoice::MODE_MIN}) {
+            auto scale = static_cast<ScaleChoice>(s);
+            for (const auto& note : notes) {
+                std::string spelled = MusicUtils::spellNote(note, scale, m);
+                bool hasOctave =
+                    std::isdigit(static_cast<unsigned char>(note.back()));
+                if (MusicUtils::pitchClass(spelled) !=
+                        MusicUtils::pitchClass(note) ||
+                    (hasOctave && MusicUtils::midiNumber(spelled) !=
+                                      MusicUtils::midiNumber(note))) {
+                    FAIL("Hauteur modifiée : " << note << " → " << spelled);
+                }
+                // Idempotence : une note orthographiée reste inchangée
+                if (MusicUtils::spellNote(spelled, scale, m) != spelled) {
+                    FAIL("Orthographe instable : " << spelled);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("noteName nomme chaque touche du piano selon la gamme") {
+    for (int s = 0; s < 7; ++s) {
+        for (auto m : {ModeChoice::MODE_MAJ, ModeChoice::MODE_MIN}) {
+            auto scale = static_cast<ScaleChoice>(s);
+            for (int32_t midi = 21; midi <= 108; ++midi) {
+                std::string name = MusicUtils::noteName(midi, scale, m);
+                if (MusicUtils::midiNumber(name) != midi ||
+                    MusicUtils::spellNote(name, scale, m) != name) {
+                    FAIL("Touche " << midi << " mal nommée : " << name);
+                }
+            }
+        }
+    }
+    CHECK(MusicUtils::noteName(63, ScaleChoice::SCALE_C,
+                               ModeChoice::MODE_MIN) == "eb4");
+    CHECK(MusicUtils::noteName(63, ScaleChoice::SCALE_E,
+                               ModeChoice::MODE_MAJ) == "d#4");
+    CHECK(MusicUtils::noteName(-1, ScaleChoice::SCALE_C,
+                               ModeChoice::MODE_MAJ)
+              .empty());
+}
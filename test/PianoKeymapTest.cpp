@@ -0,0 +1,89 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "KeyboardModel.hpp"
+#include "PianoKeymap.hpp"
+#include <array>
+#include <doctest/doctest.h>
+
+namespace {
+/// Bit d'une classe de hauteur dans `pressedPitchClasses`
+constexpr uint16_t pc(int32_t n) { return static_cast<uint16_t>(1U << n); }
+} // namespace
+
+TEST_CASE("Mêmes positions sur les deux claviers, lettres différentes") {
+    PianoKeymap qwerty;
+    qwerty.setLayout(KeyLayout::QWERTY);
+    PianoKeymap azerty;
+    azerty.setLayout(KeyLayout::AZERTY);
+
+    int32_t slot = qwerty.slotOf(KEY_Z);
+    REQUIRE(slot >= 0);
+    CHECK(azerty.slotOf(KEY_Z) == slot);
+    CHECK(PianoKeymap::offset(slot) == 0);
+    CHECK(qwerty.label(slot) == 'Z');
+    CHECK(azerty.label(slot) == 'W');
+    CHECK(azerty.label(azerty.slotOf(KEY_Q)) == 'A');
+    CHECK(PianoKeymap::offset(qwerty.slotOf(KEY_Q)) == 12);
+    CHECK(PianoKeymap::offset(qwerty.slotOf(KEY_P)) == PianoKeymap::SPAN - 1);
+
+    CHECK(qwerty.slotOf(KEY_F3) == -1);
+    CHECK(qwerty.slotOf(KEY_F) == -1);
+    PianoKeymap none;
+    none.setLayout(KeyLayout::NONE);
+    CHECK(none.slotOf(KEY_Z) == -1);
+
+    KeyLayout layout = KeyLayout::NONE;
+    CHECK(PianoKeymap::parse("qwerty", layout));
+    CHECK(layout == KeyLayout::QWERTY);
+    CHECK_FALSE(PianoKeymap::parse("dvorak", layout));
+    CHECK(layout == KeyLayout::QWERTY);
+}
+
+TEST_CASE("Appuis et relâchements d'une image en une passe, accord horodaté") {
+    KeyboardModel keyboard;
+    keyboard.setKeymap(KeyLayout::QWERTY);
+
+    // Do-mi-sol sur la rangée du bas, plus une répétition du système
+    std::array<KeyEvent, 4> events{{{KEY_Z, true, 1.000},
+                                    {KEY_C, true, 1.010},
+                                    {KEY_Z, true, 1.015},
+                                    {KEY_B, true, 1.020}}};
+    CHECK(keyboard.setTypedKeys(events, true) == 1.000);
+    CHECK(keyboard.pressedPitchClasses() == (pc(0) | pc(4) | pc(7)));
+
+    // Relâchement du mi, do et sol toujours tenus
+    std::array<KeyEvent, 1> release{{{KEY_C, false, 1.100}}};
+    CHECK(keyboard.setTypedKeys(release, true) == -1.0);
+    CHECK(keyboard.pressedPitchClasses() == (pc(0) | pc(7)));
+
+    Chord chord;
+    keyboard.setPointers({}, true, 1.2);
+    REQUIRE(keyboard.takeChord(chord));
+    REQUIRE(chord.notes.size() == 3);
+    CHECK(chord.notes[0] == NotePress{60, 1.000});
+    CHECK(chord.notes[1] == NotePress{64, 1.010});
+    CHECK(chord.notes[2] == NotePress{67, 1.020});
+    CHECK_FALSE(keyboard.takeChord(chord));
+
+    // Désactivé (pause) : touches tenues relâchées, appuis ignorés
+    CHECK(keyboard.setTypedKeys(events, false) == -1.0);
+    CHECK(keyboard.pressedPitchClasses() == 0);
+}
+
+TEST_CASE("Le do de départ suit la fenêtre du clavier virtuel") {
+    KeyboardModel keyboard;
+    keyboard.setKeymap(KeyLayout::AZERTY);
+    std::array<KeyEvent, 1> down{{{KEY_Q, true, 2.0}}};
+    keyboard.setTypedKeys(down, true);
+
+    // Une octave vers l'aigu : la même touche joue désormais do6
+    keyboard.scroll(7.0f);
+    std::array<KeyEvent, 2> next{{{KEY_Q, false, 2.1}, {KEY_Q, true, 2.2}}};
+    keyboard.setTypedKeys(next, true);
+    keyboard.setPointers({}, true, 3.0);
+
+    Chord chord;
+    REQUIRE(keyboard.takeChord(chord));
+    CHECK(chord.notes.front().midi == 72);
+    REQUIRE(keyboard.takeChord(chord));
+    CHECK(chord.notes.front().midi == 84);
+}
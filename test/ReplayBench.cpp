@@ -0,0 +1,74 @@
+#include "AllocCounter.hpp"
+#include "AppController.hpp"
+#include "Mocks.hpp"
+#include "ScriptedInput.hpp"
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <string>
+
+using namespace Mocks;
+
+namespace {
+constexpr int32_t ROUNDS{2000};  ///< Défis joués par rejeu
+constexpr double ROUND{5.0};     ///< Durée d'un défi, affichage compris
+constexpr int32_t SWEEP{30};     ///< Déplacements du pointeur par défi
+
+/// Notes des défis, parcourues en boucle
+constexpr const char* NOTES[]{"c4", "e4", "g4", "b3", "d5", "f#4", "bb3"};
+
+/**
+ * @brief Longue partie : un défi toutes les `ROUND` secondes, pointeur
+ * balayant le clavier virtuel et appuis pendant la réflexion
+ * @param script Scénario à remplir
+ * @return Durée simulée
+ */
+double longGame(ScriptedInput& script) {
+    openGame(script, 1.0,
+             Message("gametype", {{"id", "piano"},
+                                  {"name", "Piano complet"},
+                                  {"keys", "52"}}));
+    script.receive(1.1, Message("ack", {{"status", "ok"}}));
+
+    // `ready` part 2,5 s après chaque résultat : le défi suivant le suit
+    double t = 1.2;
+    for (int32_t i = 0; i < ROUNDS; ++i, t += ROUND) {
+        std::string note = NOTES[i % std::size(NOTES)];
+        script.receive(t, Message("note", {{"id", std::to_string(i + 1)},
+                                           {"note", note}}));
+        for (int32_t s = 0; s < SWEEP; ++s) {
+            float x = W * static_cast<float>(s) / SWEEP;
+            script.move(t + 0.05 * s, {x, H * 0.85f});
+        }
+        script.button(t + 1.0, true).button(t + 1.2, false);
+        script.receive(t + 2.0, Message("result", {{"correct", note}}));
+    }
+    script.receive(t, Message("over", {{"perfect", std::to_string(ROUNDS)},
+                                       {"partial", "0"},
+                                       {"total", std::to_string(ROUNDS)},
+                                       {"duration", "0"}}));
+    script.quitAt(t + 1.0);
+    return t + 1.0;
+}
+} // namespace
+
+int main() {
+    ScriptedInput script;
+    double simulated = longGame(script);
+
+    AppController app;
+    uint64_t allocBefore = AllocCounter::threadCount();
+    auto start = std::chrono::steady_clock::now();
+    app.replay(script);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocs = AllocCounter::threadCount() - allocBefore;
+
+    double wall = std::chrono::duration<double>(elapsed).count();
+    std::println("Rejeu de la logique : {} défis, {:.0f} s simulées", ROUNDS,
+                 simulated);
+    std::println("{:.1f} ms réelles, ×{:.0f} le temps réel, {} messages "
+                 "envoyés, {} allocations",
+                 wall * 1000.0, simulated / wall, script.sent().size(),
+                 allocs);
+    return 0;
+}
@@ -0,0 +1,184 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AppController.hpp"
+#include "Mocks.hpp"
+#include "ScriptedInput.hpp"
+#include <chrono>
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+using namespace Mocks;
+
+TEST_CASE("Rejeu d'une partie complète, plus vite que le temps réel") {
+    ScriptedInput script;
+    double t = openGame(script);
+    script.receive(t + 0.1, Message("ack", {{"status", "ok"}}))
+        .receive(t + 0.2, Message("note", {{"id", "1"}, {"note", "e4"}}))
+        .receive(t + 30.0, Message("result", {{"correct", "e4"}}))
+        .receive(t + 31.0, Message("over", {{"perfect", "1"},
+                                            {"partial", "0"},
+                                            {"total", "1"},
+                                            {"duration", "31000"}}))
+        .click(t + 40.0, centre({AppState::GAME_OVER, W, H, 1, 1},
+                                Widget::GAME_OVER_BACK))
+        .click(t + 41.0, centre({AppState::MENU, W, H, 1, 1},
+                                Widget::MENU_GAME))
+        .quitAt(t + 45.0);
+
+    AppController app;
+    auto start = std::chrono::steady_clock::now();
+    app.replay(script);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Retour au menu après `over`, puis nouvelle partie
+    CHECK(sentTypes(script) ==
+          std::vector<std::string>{"config", "ready", "config"});
+    CHECK(script.sent().front().getField("game") == "note");
+    CHECK(script.now() >= t + 45.0);
+    CHECK(elapsed < std::chrono::seconds(5));
+}
+
+TEST_CASE("Moteur muet : abandon de la partie au bout du délai de réponse") {
+    ScriptedInput script;
+    double t = openGame(script);
+    script.quitAt(t + 10.0);
+
+    AppController app;
+    app.replay(script);
+
+    CHECK(sentTypes(script) == std::vector<std::string>{"config", "quit"});
+}
+
+TEST_CASE("Deux rejeux d'un même scénario envoient les mêmes messages") {
+    auto run = [] {
+        ScriptedInput script;
+        double t = openGame(script);
+        script.receive(t + 0.1, Message("ack", {{"status", "ok"}}))
+            .receive(t + 0.2, Message("chord", {{"id", "1"},
+                                                {"name", "C"},
+                                                {"notes", "c4 e4 g4"}}))
+            .press(t + 0.5, InputKey::RIGHT)
+            .wheel(t + 0.6, 2.0f)
+            .receive(t + 1.0, Message("result", {{"correct", "c4 e4"},
+                                                 {"incorrect", "f4"}}))
+            .receive(t + 3.6, Message("note", {{"id", "2"}, {"note", "a4"}}))
+            .click(t + 4.0, centre({AppState::PLAY, W, H, 1, 1},
+                                   Widget::PLAY_MENU))
+            .quitAt(t + 5.0);
+        AppController app;
+        app.replay(script);
+        return script.sent();
+    };
+    std::vector<Message> first = run();
+    std::vector<Message> second = run();
+    REQUIRE(first.size() == second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        CHECK(first[i].getType() == second[i].getType());
+        CHECK(first[i].getFields() == second[i].getFields());
+    }
+    // Défi, résultat, défi suivant, puis abandon depuis l'écran de jeu
+    std::vector<std::string> types;
+    for (const Message& msg : first) types.push_back(msg.getType());
+    CHECK(types ==
+          std::vector<std::string>{"config", "ready", "ready", "quit"});
+}
+
+TEST_CASE("Appuis au clavier virtuel envoyés au moteur, accord par accord") {
+    KeyboardModel keyboard; // Même disposition que celle de la partie
+    keyboard.setLayout(7, W, H);
+    auto key = [&keyboard](int32_t midi) {
+        Rectangle r = keyboard.keyBounds(midi);
+        return Vector2{r.x + r.width / 2.0f, r.y + r.height * 0.8f};
+    };
+
+    ScriptedInput script;
+    double t = openGame(script);
+    script.receive(t + 0.1, Message("ack", {{"status", "ok"}}))
+        .receive(t + 0.2, Message("chord", {{"id", "3"},
+                                            {"name", "Do majeur"},
+                                            {"notes", "c4 e4 g4"}}))
+        .click(t + 1.0, key(60))
+        .click(t + 1.03, key(64)) // Dans la fenêtre d'accord
+        .click(t + 2.0, key(67))
+        .quitAt(t + 3.0);
+
+    AppController app;
+    app.replay(script);
+
+    REQUIRE(sentTypes(script) ==
+            std::vector<std::string>{"config", "ready", "play", "play"});
+    const Message& chord = script.sent()[2];
+    CHECK(chord.getField("id") == "3");
+    CHECK(chord.getField("notes") == "c4 e4");
+    CHECK(chord.getField("offsets").starts_with("0 ")); // Écart < fenêtre
+    CHECK(chord.getField("time") == "2000");
+    CHECK(std::stoi(chord.getField("age")) >= 50);
+    CHECK(script.sent()[3].getField("notes") == "g4");
+}
+
+TEST_CASE("Clavier de l'ordinateur : accord tenu, appuis datés à l'événement") {
+    ScriptedInput script;
+    double t = openGame(script);
+    // Rangée du bas : do, mi, sol depuis do4 ; dates entre deux images
+    script.receive(t + 0.1, Message("ack", {{"status", "ok"}}))
+        .receive(t + 0.2, Message("chord", {{"id", "4"},
+                                            {"name", "Do majeur"},
+                                            {"notes", "c4 e4 g4"}}))
+        .keyDown(t + 1.005, KEY_Z)
+        .keyDown(t + 1.012, KEY_B)
+        .keyDown(t + 1.012, KEY_B) // Répétition du système, ignorée
+        .keyUp(t + 1.5, KEY_Z)
+        .keyUp(t + 1.5, KEY_B)
+        .keyDown(t + 2.0, KEY_C)
+        .keyUp(t + 2.1, KEY_C)
+        .quitAt(t + 3.0);
+
+    AppController app;
+    app.replay(script);
+
+    REQUIRE(sentTypes(script) ==
+            std::vector<std::string>{"config", "ready", "play", "play"});
+    const Message& chord = script.sent()[2];
+    CHECK(chord.getField("id") == "4");
+    CHECK(chord.getField("notes") == "c4 g4");
+    CHECK(chord.getField("time") == "2005");
+    CHECK(chord.getField("offsets") == "0 7");
+    CHECK(script.sent()[3].getField("notes") == "e4");
+}
+
+TEST_CASE("Lien coupé : les touches du piano réel ne restent pas enfoncées") {
+    ScriptedInput script;
+    script.receive(0.1, Message("noteon", {{"note", "c4"}, {"velocity", "90"}}))
+        .dropLink(0.5) // Avant le `noteoff` du do, perdu avec le lien
+        .receive(1.0, Message("noteon", {{"note", "e4"}, {"velocity", "60"}}))
+        .quitAt(1.5);
+
+    Communication comm;
+    script.attach(comm);
+    REQUIRE(comm.connect());
+    InputFrame frame;
+    auto runUntil = [&](double time) {
+        while (script.now() < time) {
+            script.poll(frame);
+            script.present();
+        }
+    };
+
+    KeyStates keys;
+    runUntil(0.2);
+    REQUIRE(comm.takeKeyStates(keys));
+    CHECK(keys.held[60]);
+
+    runUntil(0.6);
+    CHECK_FALSE(comm.isConnected());
+    REQUIRE(comm.takeKeyStates(keys)); // Relâchement reporté à l'image
+    CHECK(keys.held.none());
+
+    // Lien rétabli : seules les nouvelles frappes sont tenues
+    REQUIRE(comm.connect());
+    runUntil(1.1);
+    REQUIRE(comm.takeKeyStates(keys));
+    CHECK(keys.held.count() == 1);
+    CHECK(keys.held[64]);
+    script.detach();
+}
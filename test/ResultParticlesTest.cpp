@@ -0,0 +1,81 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "AllocCounter.hpp"
+#include "ResultParticles.hpp"
+#include <doctest/doctest.h>
+
+namespace {
+constexpr Rectangle KEY{100.0f, 560.0f, 24.0f, 240.0f};
+} // namespace
+
+TEST_CASE("Une gerbe jaillit de la touche puis s'éteint") {
+    ResultParticles effects;
+    effects.burst(KEY, GREEN, 100);
+    effects.popup({640.0f, 200.0f}, "+10", GOLD);
+    CHECK(effects.count() == 100);
+    CHECK(effects.popups() == 1);
+
+    CHECK(effects.animate(0.1f));
+    CHECK(effects.count() == 100);
+    // Au plus une durée de vie : tout s'est éteint, une dernière image
+    // efface ce qui restait
+    CHECK(effects.animate(ResultParticles::LIFETIME));
+    CHECK(effects.count() == 0);
+    CHECK(effects.popups() == 0);
+    CHECK_FALSE(effects.animate(0.1f));
+}
+
+TEST_CASE("Même graine, mêmes gerbes, particule par particule") {
+    ResultParticles a;
+    ResultParticles b;
+    for (ResultParticles* effects : {&a, &b}) {
+        effects->burst(KEY, RED, 500);
+        for (int i = 0; i < 20; ++i) (void)effects->animate(1.0f / 60.0f);
+    }
+    REQUIRE(a.count() == b.count());
+    REQUIRE(a.count() > 0);
+    size_t same = 0;
+    for (size_t i = 0; i < a.count(); ++i) {
+        Rectangle ra = a.rect(i);
+        Rectangle rb = b.rect(i);
+        same += ra.x == rb.x && ra.y == rb.y && ra.width == rb.width &&
+                ra.height == rb.height;
+    }
+    CHECK(same == a.count());
+    // Tirages distincts d'une particule à l'autre
+    CHECK(a.rect(0).x != a.rect(1).x);
+}
+TEST_CASE("Les points les plus anciens cèdent la place") {
+    ResultParticles effects;
+    for (size_t i = 0; i < ResultParticles::POPUP_CAPACITY + 3; ++i) {
+        effects.popup({0.0f, 0.0f}, "+5", ORANGE);
+        (void)effects.animate(0.01f);
+    }
+    CHECK(effects.popups() == ResultParticles::POPUP_CAPACITY);
+}
+
+TEST_CASE("Gerbe tronquée à la réserve, places rendues à l'extinction") {
+    ResultParticles effects;
+    uint64_t before = AllocCounter::threadCount();
+    effects.burst(KEY, GREEN, ResultParticles::CAPACITY + 40);
+    CHECK(effects.count() == ResultParticles::CAPACITY);
+    CHECK(effects.dropped() == 40);
+
+    // Départ du bord haut de la touche, puis montée
+    Rectangle first = effects.rect(0);
+    CHECK(first.y + first.height / 2.0f == doctest::Approx(KEY.y));
+    CHECK(first.x + first.width / 2.0f >= KEY.x);
+    CHECK(first.x + first.width / 2.0f <= KEY.x + KEY.width);
+    (void)effects.animate(0.1f);
+    CHECK(effects.rect(0).y < first.y);
+
+    // Vie d'au moins une demi-durée : personne ne s'éteint avant
+    (void)effects.animate(ResultParticles::LIFETIME * 0.5f - 0.11f);
+    CHECK(effects.count() == ResultParticles::CAPACITY);
+    while (effects.count() == ResultParticles::CAPACITY) {
+        (void)effects.animate(1.0f / 60.0f);
+    }
+    effects.burst(KEY, RED, ResultParticles::CAPACITY - effects.count());
+    CHECK(effects.count() == ResultParticles::CAPACITY);
+    CHECK(effects.dropped() == 40);
+    CHECK(AllocCounter::threadCount() == before);
+}
@@ -0,0 +1,120 @@
+#include "Communication.hpp"
+#include "ThreadTuning.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <print>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+constexpr const char* SOCKET_PATH = "/tmp/smartpiano.bench.sock";
+constexpr int32_t MESSAGES = 2000; ///< Messages par scénario
+
+/// Scénario d'ordonnancement du thread d'écoute
+struct Scenario {
+    const char* name;
+    ThreadPolicy policy;
+};
+
+/**
+ * @brief Horodatage monotone en nanosecondes
+ * @return Nanosecondes depuis l'époque de `steady_clock`
+ */
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Mesure la latence écriture socket → file de `Communication`
+ * @param policy Politique du thread d'écoute
+ * @return Latences en microsecondes, triées
+ */
+std::vector<int64_t> measure(const ThreadPolicy& policy) {
+    unlink(SOCKET_PATH);
+    int32_t listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::copy_n(SOCKET_PATH, std::char_traits<char>::length(SOCKET_PATH) + 1,
+                addr.sun_path);
+    (void)bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    (void)listen(listenFd, 1);
+
+    Communication comm(SOCKET_PATH);
+    comm.setThreadPolicy(policy);
+    if (!comm.connect()) return {};
+    int32_t fd = accept(listenFd, nullptr, nullptr);
+
+    // Faux moteur : un message horodaté par milliseconde
+    std::thread writer([fd] {
+        for (int32_t i = 0; i < MESSAGES; ++i) {
+            std::string data = serialize(
+                Message("bench", {{"t", std::to_string(nowNs())}}));
+            (void)write(fd, data.data(), data.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(MESSAGES);
+    while (static_cast<int32_t>(latencies.size()) < MESSAGES) {
+        auto msg = comm.popMessage();
+        if (!msg) {
+            std::this_thread::yield();
+            continue;
+        }
+        latencies.push_back((nowNs() - std::stoll(msg->getField("t"))) / 1000);
+    }
+    writer.join();
+    comm.disconnect();
+    close(fd);
+    close(listenFd);
+    unlink(SOCKET_PATH);
+    std::ranges::sort(latencies);
+    return latencies;
+}
+} // namespace
+
+int main() {
+    auto cores = static_cast<int32_t>(std::thread::hardware_concurrency());
+    int32_t lastCore = std::max(cores - 1, 0);
+
+    // Charge CPU synthétique : un thread actif par cœur
+    std::atomic<bool> loaded{true};
+    std::vector<std::thread> load;
+    for (int32_t i = 0; i < cores; ++i) {
+        load.emplace_back([&loaded] {
+            volatile uint64_t spin = 0;
+            while (loaded.load(std::memory_order_relaxed)) spin = spin + 1;
+        });
+    }
+
+    const Scenario scenarios[] = {
+        {"CFS par défaut", {}},
+        {"nice -10", {.nice = -10}},
+        {"cœur dédié", {.cpu = lastCore}},
+        {"SCHED_FIFO 10", {.fifoPriority = 10}},
+        {"cœur + SCHED_FIFO 10", {.cpu = lastCore, .fifoPriority = 10}},
+    };
+    std::println("Latence socket → file, {} messages, charge sur {} cœurs",
+                 MESSAGES, cores);
+    for (const auto& scenario : scenarios) {
+        auto lat = measure(scenario.policy);
+        if (lat.empty()) {
+            std::println("{:<22} connexion impossible", scenario.name);
+            continue;
+        }
+        std::println("{:<22} p50 {:>6} µs  p99 {:>6} µs  max {:>6} µs",
+                     scenario.name, lat[lat.size() / 2],
+                     lat[lat.size() * 99 / 100], lat.back());
+    }
+    loaded = false;
+    for (auto& t : load) t.join();
+    return 0;
+}
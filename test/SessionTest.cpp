@@ -0,0 +1,99 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "Session.hpp"
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+namespace {
+/// Compte les destructions, pour vérifier la libération du cadre
+struct Guard {
+    int& destroyed;
+    ~Guard() { ++destroyed; }
+};
+
+/**
+ * @brief Session réduite : ack, puis défis jusqu'à `over` ou expiration
+ * @param driver Ordonnanceur
+ * @param trace Étapes franchies
+ * @param destroyed Compteur de destruction des variables locales
+ */
+SessionTask miniSession(SessionDriver& driver, std::vector<std::string>& trace,
+                        int& destroyed) {
+    Guard guard{destroyed};
+    auto ack = co_await driver.receive(1.0f, "ack");
+    trace.push_back(ack ? "ack" : "timeout");
+    if (!ack) co_return;
+    while (true) {
+        auto msg = co_await driver.receive(SessionDriver::NO_TIMEOUT, "note",
+                                           "over");
+        if (!msg || msg->getType() == "over") break;
+        trace.push_back(msg->getField("note"));
+        auto pause = co_await driver.receive(2.0f, "over");
+        trace.push_back(pause ? "over" : "next");
+        if (pause) break;
+    }
+    trace.push_back("end");
+}
+} // namespace
+
+TEST_CASE("SessionDriver remet les messages attendus") {
+    SessionDriver driver;
+    std::vector<std::string> trace;
+    int destroyed = 0;
+    driver.start(miniSession(driver, trace, destroyed));
+    CHECK(driver.active());
+
+    // Type non attendu : laissé à l'appelant
+    CHECK(driver.deliver(Message("note", {{"note", "c4"}})) == false);
+    CHECK(driver.deliver(Message("ack", {{"status", "ok"}})) == true);
+    CHECK(driver.deliver(Message("note", {{"note", "e4"}})) == true);
+    driver.tick(2.5f); // Fin du délai d'affichage
+    CHECK(driver.deliver(Message("note", {{"note", "g4"}})) == true);
+    driver.skip(); // Délai écourté
+    CHECK(driver.deliver(Message("over")) == true);
+
+    CHECK(trace == std::vector<std::string>{"ack", "e4", "next", "g4", "next",
+                                            "end"});
+    CHECK(driver.active() == false);
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("SessionDriver expire l'attente au tic d'image") {
+    SessionDriver driver;
+    std::vector<std::string> trace;
+    int destroyed = 0;
+    driver.start(miniSession(driver, trace, destroyed));
+    CHECK(driver.tick(0.6f) == false);
+    CHECK(trace.empty());
+    CHECK(driver.timeLeft() == doctest::Approx(0.4f));
+    CHECK(driver.tick(0.6f) == true);
+    CHECK(trace == std::vector<std::string>{"timeout"});
+    CHECK(driver.timeLeft() == 0.0f);
+    CHECK(driver.active() == false);
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("SessionDriver annule une session suspendue") {
+    SessionDriver driver;
+    std::vector<std::string> trace;
+    int destroyed = 0;
+    driver.start(miniSession(driver, trace, destroyed));
+    CHECK(driver.deliver(Message("ack")) == true);
+
+    // Attente sans limite : le tic n'a pas d'effet
+    driver.tick(100.0f);
+    CHECK(driver.active());
+
+    driver.cancel();
+    CHECK(driver.active() == false);
+    CHECK(destroyed == 1);
+    CHECK(driver.deliver(Message("note", {{"note", "c4"}})) == false);
+
+    // Une nouvelle session remplace la précédente
+    int destroyedFirst = 0;
+    driver.start(miniSession(driver, trace, destroyedFirst));
+    driver.start(miniSession(driver, trace, destroyed));
+    CHECK(destroyedFirst == 1);
+    CHECK(driver.deliver(Message("ack")) == true);
+    CHECK(trace == std::vector<std::string>{"ack", "ack"});
+}
@@ -0,0 +1,233 @@
+#include "AppController.hpp"
+#include "DrawList.hpp"
+#include "UI.hpp"
+#include "rlgl.h"
+#include <GLFW/glfw3.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <print>
+
+namespace {
+constexpr int WARMUP_FRAMES{30}; ///< Remplissage des caches (couches, textes)
+constexpr int FRAMES{200};
+constexpr int BATCH_QUADS{1 << 15}; ///< Lot assez grand pour une image entière
+constexpr int RAIN_CHORDS{20};      ///< Accords de onze notes en chute
+
+/// Résolutions mesurées : écran tactile de la Pi, puis écrans courants
+constexpr std::array<std::array<int, 2>, 4> RESOLUTIONS{
+    {{1280, 800}, {1024, 600}, {1920, 1080}, {2560, 1440}}};
+constexpr std::array<NotationMode, 3> NOTATIONS{
+    NotationMode::SYLLABIC, NotationMode::LETTER, NotationMode::STAFF};
+constexpr std::array<const char*, 3> NOTATION_NAMES{"syllabes", "lettres",
+                                                    "portée"};
+
+/// Écran synthétique mesuré
+enum class Scenario : uint8_t {
+    PROFILES,    ///< Quatre profils
+    MENU,        ///< Trois types de jeu
+    PLAY_CHORD,  ///< Grand accord, clavier complet, résultat partiel
+    PLAY_PAUSED, ///< Même partie sous le menu de pause
+    PLAY_RAIN,   ///< Même partie, deux cents notes qui tombent
+    PLAY_BURST,  ///< Même partie, réserve de particules pleine
+    GAME_OVER,
+    COUNT
+};
+constexpr std::array<const char*, static_cast<size_t>(Scenario::COUNT)>
+    SCENARIO_NAMES{"profils", "menu",   "accord", "pause",
+                   "cascade", "gerbes", "fin"};
+
+/// Mesures d'une configuration, par image
+struct Measure {
+    double wallMs{0.0};
+    double cpuMs{0.0}; ///< Processus entier, rastériseur logiciel compris
+    int drawCalls{0};
+    int vertices{0};
+};
+} // namespace
+
+/**
+ * @brief Benchmark de rendu hors écran : `UI::record` puis soumission de la
+ * liste, sur des états synthétiques de l'application, dans une texture de
+ * rendu, sans affichage
+ */
+class UIBench {
+  private:
+    /**
+     * @brief Place l'application dans un écran synthétique
+     * @param app Application, fenêtre déjà créée
+     * @param scenario Écran voulu
+     * @param notation Notation des notes
+     * @param w Largeur de l'écran
+     * @param h Hauteur de l'écran
+     */
+    static void prepare(AppController& app, Scenario scenario,
+                        NotationMode notation, float w, float h) {
+        app.profiles_ = {{"Alice", 1200, SKYBLUE},
+                         {"Bruno", 800, ORANGE},
+                         {"Chloé", 450, LIME},
+                         {"Dario", 90, PINK}};
+        app.availableGames_ = {{"note", "Notes isolées", 7},
+                               {"chord", "Accords", 14},
+                               {"piano", "Piano complet", 52}};
+        app.selectedNotation_ = notation;
+        app.isPaused_ = scenario == Scenario::PLAY_PAUSED;
+        app.showFallingNotes_ = scenario == Scenario::PLAY_RAIN;
+        app.engState_ = EngineState::ENG_CONNECTED;
+
+        switch (scenario) {
+        case Scenario::PROFILES:
+            app.appState_ = AppState::PROFILE_SELECT;
+            break;
+        case Scenario::MENU: app.appState_ = AppState::MENU; break;
+        case Scenario::PLAY_CHORD:
+        case Scenario::PLAY_PAUSED:
+        case Scenario::PLAY_RAIN:
+        case Scenario::PLAY_BURST:
+            // Session lancée sans moteur : elle attend `ack` indéfiniment
+            app.startGame("piano");
+            app.isPaused_ = scenario == Scenario::PLAY_PAUSED;
+            app.applyChallenge(Message(
+                "chord", {{"id", "1"},
+                          {"name", "C13"},
+                          {"notes", "c2 g2 e3 bb3 d4 f4 a4 c5 e5 g5 bb5"}}));
+            app.applyResult(
+                Message("result", {{"correct", "c2 g2 e3 bb3 d4 f4 a4"},
+                                   {"incorrect", "c#5 f5"}}));
+            app.keyboard_.setLayout(KeyboardModel::NUM_WHITE, w, h);
+            app.playView_.setLayout(w, h);
+            // Accords successifs, échelonnés pendant leur fondu
+            for (int i = 0; app.showFallingNotes_ && i < RAIN_CHORDS; ++i) {
+                app.falling_.setChallenge(app.currentChallenge_.expectedNotes,
+                                          SKYBLUE);
+                app.falling_.animate(FallingNotes::FADE_TIME / RAIN_CHORDS);
+            }
+            // Gerbes du résultat, à la disposition mesurée
+            app.effects_.clear();
+            while (scenario == Scenario::PLAY_BURST &&
+                   app.effects_.count() < ResultParticles::CAPACITY) {
+                app.burstResultKeys();
+                app.effects_.animate(1.0f / 60.0f);
+            }
+            break;
+        case Scenario::GAME_OVER:
+            app.finishGame(Message("over", {{"perfect", "8"},
+                                            {"partial", "3"},
+                                            {"total", "12"},
+                                            {"duration", "95000"}}));
+            break;
+        case Scenario::COUNT: break;
+        }
+        app.refreshLayout({-1.0f, -1.0f}, w, h);
+    }
+
+    /**
+     * @brief Mesure le rendu d'un écran dans une texture
+     * @param app Application préparée
+     * @param target Texture de rendu à la taille de l'écran
+     * @param batch Lot de rendu actif, compté à chaque envoi
+     * @return Mesures moyennes par image
+     */
+    static Measure measure(AppController& app, RenderTexture2D target,
+                           const rlRenderBatch& batch) {
+        auto w = static_cast<float>(target.texture.width);
+        auto h = static_cast<float>(target.texture.height);
+        Measure m;
+        DrawList list; // Capacités acquises pendant le préchauffage
+        auto frame = [&](const BatchProbe& probe) {
+            BeginTextureMode(target);
+            ClearBackground(BLACK);
+            list.clear();
+            UI::record(app, list, w, h);
+            list.submit(probe);
+            if (probe) probe(true); // Envoi de fin d'image
+            EndTextureMode();
+        };
+        for (int i = 0; i < WARMUP_FRAMES; ++i) frame({});
+
+        auto start = std::chrono::steady_clock::now();
+        std::clock_t cpuStart = std::clock();
+        for (int i = 0; i < FRAMES; ++i) frame({});
+        // Relecture : attend la fin du rendu en file
+        UnloadImage(LoadImageFromTexture(target.texture));
+        std::clock_t cpuEnd = std::clock();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        m.wallMs =
+            std::chrono::duration<double, std::milli>(elapsed).count() / FRAMES;
+        m.cpuMs = 1000.0 * static_cast<double>(cpuEnd - cpuStart) /
+                  CLOCKS_PER_SEC / FRAMES;
+
+        // Comptes sur une image de plus, hors chronométrage : le contenu du
+        // lot est relevé puis envoyé avant chaque envoi de raylib, qui le
+        // remet à zéro (mode de fusion, cible, appels épuisés)
+        auto flush = [&] {
+            for (int i = 0; i < batch.drawCounter; ++i) {
+                if (batch.draws[i].vertexCount == 0) continue;
+                ++m.drawCalls;
+                m.vertices += batch.draws[i].vertexCount;
+            }
+            rlDrawRenderBatchActive();
+        };
+        frame([&](bool flushing) {
+            // Quelques appels de marge : une commande en ouvre au plus deux
+            if (flushing ||
+                batch.drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS - 4) {
+                flush();
+            }
+        });
+        return m;
+    }
+
+  public:
+    static int run() {
+        // Rastériseur logiciel de Mesa, sauf choix contraire de l'appelant
+        setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+        SetTraceLogLevel(LOG_WARNING);
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+        InitWindow(320, 240, "UIBench");
+        if (!IsWindowReady()) {
+            std::println(stderr, "Contexte OpenGL indisponible (DISPLAY ?)");
+            return EXIT_FAILURE;
+        }
+
+        {
+            AppController app;
+            app.text_.load("");
+            app.assets_.preload();
+            app.assets_.upload();
+            rlRenderBatch batch = rlLoadRenderBatch(1, BATCH_QUADS);
+            rlSetRenderBatchActive(&batch);
+
+            std::println("{:<8} {:<9} {:>10} {:>9} {:>9} {:>7} {:>8}",
+                         "écran", "notation", "résolution", "ms/image",
+                         "ms CPU", "appels", "sommets");
+            for (auto [w, h] : RESOLUTIONS) {
+                RenderTexture2D target = LoadRenderTexture(w, h);
+                for (size_t n = 0; n < NOTATIONS.size(); ++n) {
+                    for (size_t s = 0; s < SCENARIO_NAMES.size(); ++s) {
+                        prepare(app, static_cast<Scenario>(s), NOTATIONS[n],
+                                static_cast<float>(w), static_cast<float>(h));
+                        Measure m = measure(app, target, batch);
+                        std::println("{:<8} {:<9} {:>5}x{:<4} {:>9.3f} "
+                                     "{:>9.3f} {:>7} {:>8}",
+                                     SCENARIO_NAMES[s], NOTATION_NAMES[n], w,
+                                     h, m.wallMs, m.cpuMs, m.drawCalls,
+                                     m.vertices);
+                    }
+                }
+                UnloadRenderTexture(target);
+            }
+
+            rlSetRenderBatchActive(nullptr);
+            rlUnloadRenderBatch(batch);
+        } // ~AppController : libère atlas et textures, ferme la fenêtre
+        return EXIT_SUCCESS;
+    }
+};
+
+int main() { return UIBench::run(); }
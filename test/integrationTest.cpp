@@ -2,11 +2,112 @@
 #include "Communication.hpp"
 #include "Message.hpp"
 #include "MusicUtils.hpp"
+#include <atomic>
+#include <chrono>
 #include <doctest/doctest.h>
 #include <map>
 #include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
+namespace {
+/**
+ * @brief Faux moteur : accepte un client et répond aux `ping` tant que
+ * `answer` est vrai ; avec `hangUp`, cesse de lire au `ping` suivant
+ */
+class FakeEngine {
+  private:
+    std::string path_;
+    int32_t listenFd_{-1};
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+
+  public:
+    std::atomic<bool> answer{true};
+    std::atomic<bool> hangUp{false};
+    std::atomic<int32_t> pings{0};
+
+    explicit FakeEngine(std::string path) : path_(std::move(path)) {
+        unlink(this->path_.c_str());
+        this->listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::copy_n(this->path_.c_str(), this->path_.size() + 1,
+                    addr.sun_path);
+        (void)bind(this->listenFd_, reinterpret_cast<sockaddr*>(&addr),
+                   sizeof(addr));
+        (void)::listen(this->listenFd_, 1);
+        this->thread_ = std::thread([this] { this->serve(); });
+    }
+
+    ~FakeEngine() {
+        this->running_ = false;
+        shutdown(this->listenFd_, SHUT_RDWR);
+        close(this->listenFd_);
+        this->thread_.join();
+        unlink(this->path_.c_str());
+    }
+
+    FakeEngine(const FakeEngine&) = delete;
+    FakeEngine& operator=(const FakeEngine&) = delete;
+    FakeEngine(FakeEngine&&) = delete;
+    FakeEngine& operator=(FakeEngine&&) = delete;
+
+  private:
+    void serve() {
+        int32_t fd = accept(this->listenFd_, nullptr, nullptr);
+        if (fd < 0) return;
+        std::string pending;
+        char buf[512];
+        while (this->running_) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0) break;
+            pending.append(buf, static_cast<size_t>(n));
+            size_t end;
+            while ((end = pending.find("\n\n")) != std::string::npos) {
+                Message msg = deserialize(pending.substr(0, end));
+                pending.erase(0, end + 2);
+                if (msg.getType() != "ping") continue;
+                ++this->pings;
+                if (this->hangUp) {
+                    // Lecture fermée, socket ouvert : le client ne voit pas
+                    // de fin de flux, seul son prochain envoi échoue
+                    shutdown(fd, SHUT_RD);
+                    while (this->running_) {
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(5));
+                    }
+                    close(fd);
+                    return;
+                }
+                if (!this->answer) continue;
+                std::string pong = serialize(
+                    Message("pong", {{"seq", msg.getField("seq")}}));
+                (void)write(fd, pong.data(), pong.size());
+            }
+        }
+        close(fd);
+    }
+};
+
+/**
+ * @brief Attend qu'une condition devienne vraie
+ * @return `true` si vraie avant l'expiration du délai
+ */
+template <typename Pred>
+bool waitFor(Pred pred, std::chrono::milliseconds timeout) {
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < end) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+} // namespace
+
 TEST_CASE("Message Class Structure") {
     SUBCASE("Constructor with Type Only") {
         Message msg("ready");
@@ -173,6 +274,78 @@ TEST_CASE("MusicUtils Calculations") {
         CHECK(isSameNoteClass("c#4", "c#5") == true);
     }
 
+    SUBCASE("pitchClass and midiNumber") {
+        CHECK(pitchClass("c") == 0);
+        CHECK(pitchClass("c#4") == 1);
+        CHECK(pitchClass("db4") == 1);
+        CHECK(pitchClass("e#") == 5);
+        CHECK(pitchClass("b#3") == 0);
+        CHECK(pitchClass("cb") == 11);
+        CHECK(pitchClass("fx") == 7);
+        CHECK(pitchClass("f##") == 7);
+        CHECK(pitchClass("ebb") == 2);
+        CHECK(pitchClass("h4") == -1);
+        CHECK(pitchClass("") == -1);
+        CHECK(midiNumber("c4") == 60);
+        CHECK(midiNumber("a4") == 69);
+        CHECK(midiNumber("b#3") == 60);
+        CHECK(midiNumber("cb4") == 59);
+        CHECK(midiNumber("c") == 60);
+    }
+
+    SUBCASE("getScaleSpelling") {
+        const auto& cMaj =
+            getScaleSpelling(ScaleChoice::SCALE_C, ModeChoice::MODE_MAJ);
+        CHECK(cMaj[0] == "c");
+        CHECK(cMaj[1] == "c#");
+        const auto& cMin =
+            getScaleSpelling(ScaleChoice::SCALE_C, ModeChoice::MODE_MIN);
+        CHECK(cMin[3] == "eb");
+        CHECK(cMin[11] == "b"); // Sensible
+        const auto& dMin =
+            getScaleSpelling(ScaleChoice::SCALE_D, ModeChoice::MODE_MIN);
+        CHECK(dMin[1] == "c#"); // Sensible, malgré l'armure bémolisée
+        CHECK(dMin[10] == "bb");
+        const auto& fMaj =
+            getScaleSpelling(ScaleChoice::SCALE_F, ModeChoice::MODE_MAJ);
+        CHECK(fMaj[6] == "gb");
+        // Chaque gamme couvre les 12 classes, dans la bonne hauteur
+        for (int s = 0; s < 7; ++s) {
+            for (auto m : {ModeChoice::MODE_MAJ, ModeChoice::MODE_MIN}) {
+                const auto& sp =
+                    getScaleSpelling(static_cast<ScaleChoice>(s), m);
+                for (int pc = 0; pc < 12; ++pc) {
+                    CHECK(pitchClass(sp[pc]) == pc);
+                }
+            }
+        }
+    }
+
+    SUBCASE("spellNote") {
+        auto cMin = [](std::string_view n) {
+            return spellNote(n, ScaleChoice::SCALE_C, ModeChoice::MODE_MIN);
+        };
+        CHECK(cMin("d#4") == "eb4");
+        CHECK(cMin("g#3") == "ab3");
+        CHECK(cMin("c4") == "c4");
+        CHECK(cMin("d#") == "eb");
+        auto eMaj = [](std::string_view n) {
+            return spellNote(n, ScaleChoice::SCALE_E, ModeChoice::MODE_MAJ);
+        };
+        CHECK(eMaj("ab4") == "g#4");
+        CHECK(eMaj("e#4") == "f4");
+        CHECK(eMaj("fb4") == "e4");
+        CHECK(eMaj("b#3") == "c4"); // Changement d'octave
+        CHECK(eMaj("cb4") == "b3");
+        CHECK(eMaj("ebb4") == "d4");
+        CHECK(eMaj("fx4") == "g4");
+        CHECK(eMaj("xyz") == "xyz"); // Invalide, inchangée
+        auto chord = spellNotes({"c4", "d#4", "g4"}, ScaleChoice::SCALE_C,
+                                ModeChoice::MODE_MIN);
+        REQUIRE(chord.size() == 3);
+        CHECK(chord[1] == "eb4");
+    }
+
     SUBCASE("noteInList") {
         CHECK(noteInList("c4", {"c4", "e4"}) == true);
         CHECK(noteInList("c5", {"c4", "e4"}) ==
@@ -180,3 +353,105 @@ TEST_CASE("MusicUtils Calculations") {
         CHECK(noteInList("d4", {"c4", "e4"}) == false);
     }
 }
+
+TEST_CASE("RttHistogram") {
+    RttHistogram h;
+    CHECK(h.count() == 0);
+    CHECK(h.percentile(0.5) == 0);
+
+    for (int i = 0; i < 90; ++i) h.record(100); // Tranche [64, 128[
+    for (int i = 0; i < 10; ++i) h.record(5000); // Tranche [4096, 8192[
+    CHECK(h.count() == 100);
+    CHECK(h.percentile(0.5) == 127);
+    CHECK(h.percentile(0.95) == 8191);
+
+    // Fenêtre glissante : les anciens échantillons sont évincés
+    for (size_t i = 0; i < RttHistogram::WINDOW; ++i) h.record(1);
+    CHECK(h.count() == RttHistogram::WINDOW);
+    CHECK(h.percentile(0.99) == 1);
+    CHECK(h.buckets()[0] == RttHistogram::WINDOW);
+}
+
+TEST_CASE("Communication heartbeat and stall detection") {
+    const std::string path = "/tmp/smartpiano.test.heartbeat.sock";
+    FakeEngine engine(path);
+    Communication comm(path);
+    comm.setHeartbeat(std::chrono::milliseconds(20),
+                      std::chrono::milliseconds(150));
+    REQUIRE(comm.connect());
+
+    // Le moteur répond : RTT mesurés, pas de blocage, pong non transmis
+    CHECK(waitFor([&] { return comm.linkStats().pongs >= 3; },
+                  std::chrono::seconds(2)));
+    LinkStats stats = comm.linkStats();
+    CHECK(stats.stalled == false);
+    CHECK(stats.pings >= stats.pongs);
+    CHECK(stats.p50Us > 0);
+    CHECK(comm.popMessage().has_value() == false);
+
+    // Le moteur se tait : blocage détecté après le délai
+    engine.answer = false;
+    CHECK(waitFor([&] { return comm.isStalled(); }, std::chrono::seconds(2)));
+
+    // Le moteur répond de nouveau : blocage levé au pong suivant
+    engine.answer = true;
+    CHECK(waitFor([&] { return !comm.isStalled(); }, std::chrono::seconds(2)));
+    comm.disconnect();
+    CHECK(comm.isConnected() == false);
+}
+
+TEST_CASE("Communication survives a ping to an engine that hung up") {
+    const std::string path = "/tmp/smartpiano.test.hangup.sock";
+    FakeEngine engine(path);
+    Communication comm(path);
+    std::atomic<int32_t> wakes{0};
+    comm.setWakeHandler([&] { ++wakes; });
+    comm.setHeartbeat(std::chrono::milliseconds(20),
+                      std::chrono::milliseconds(1000));
+    REQUIRE(comm.connect());
+    REQUIRE(waitFor([&] { return comm.linkStats().pongs >= 1; },
+                    std::chrono::seconds(2)));
+
+    // Écriture sur un socket fermé : sans MSG_NOSIGNAL, SIGPIPE tuerait le
+    // processus de test
+    engine.hangUp = true;
+    int32_t before = wakes;
+    CHECK(waitFor([&] { return !comm.isConnected(); },
+                  std::chrono::seconds(2)));
+    CHECK(wakes > before);
+    comm.disconnect();
+}
+
+TEST_CASE("Communication coalesces live key events") {
+    Communication comm;
+    comm.setLoopback([](const Message&) {});
+    REQUIRE(comm.connect());
+    KeyStates keys;
+    CHECK_FALSE(comm.takeKeyStates(keys));
+
+    // Passage rapide : 400 événements avant le relevé de l'image
+    for (int i = 0; i < 100; ++i) {
+        comm.inject(Message("noteon", {{"note", "c4"}, {"velocity", "90"}}));
+        comm.inject(Message("noteoff", {{"note", "c4"}}));
+        comm.inject(Message("noteon", {{"note", "e4"}, {"velocity", "40"}}));
+        comm.inject(Message("noteon", {{"note", "e4"}, {"velocity", "0"}}));
+    }
+    comm.inject(Message("noteon", {{"note", "g4"}, {"velocity", "127"}}));
+    REQUIRE(comm.takeKeyStates(keys));
+    CHECK(keys.events == 401);
+    CHECK(keys.struck.count() == 3);
+    CHECK(keys.held.count() == 1);
+    CHECK(keys.held[67]);
+    CHECK(keys.velocity[60] == 90);
+    CHECK(keys.velocity[64] == 40);
+    CHECK(comm.popMessage().has_value() == false); // Hors de la file
+
+    // Relevé suivant : frappes oubliées, touche toujours tenue
+    comm.inject(Message("noteon", {{"note", "zz"}, {"velocity", "64"}}));
+    CHECK_FALSE(comm.takeKeyStates(keys));
+    comm.inject(Message("noteoff", {{"note", "g4"}}));
+    REQUIRE(comm.takeKeyStates(keys));
+    CHECK(keys.struck.none());
+    CHECK(keys.held.none());
+    comm.disconnect();
+}